@@ -0,0 +1,196 @@
+#include <loon/async_spsc.hpp>
+#include <loon/spsc.hpp>
+#include <loon/wait.hpp>
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <coroutine>
+#include <cstdint>
+#include <ctime>
+#include <exception>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+
+static int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t thread_cpu_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+}
+
+constexpr int64_t STOP = -1;
+
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+// Minimal event loop: resumed handles are posted to a queue drained by one thread that
+// parks while idle, as an I/O service's scheduler would.
+using HandleQueue = loon::BlockingQueue<loon::SpscQueue<void*, 64>, loon::ParkWait<>>;
+
+struct LoopExecutor {
+  HandleQueue* handles;
+  void operator()(std::coroutine_handle<> handle) const { handles->push_wait(handle.address()); }
+};
+
+struct Stats {
+  int64_t latency_sum = 0;
+  int64_t received = 0;
+  bool done = false;
+};
+
+template <typename Queue>
+static Detached consume(Queue& queue, Stats& stats) {
+  for (;;) {
+    const int64_t sent_at = co_await queue.pop_async();
+    if (sent_at == STOP)
+      break;
+    stats.latency_sum += now_ns() - sent_at;
+    ++stats.received;
+  }
+  stats.done = true;
+}
+
+static void report(benchmark::State& state, const Stats& stats, int64_t consumer_cpu,
+                   int64_t wall) {
+  state.counters["consumer_cpu_pct"] = 100.0 * static_cast<double>(consumer_cpu) / wall;
+  state.counters["handoff_latency_ns"] =
+      stats.received == 0
+          ? 0.0
+          : static_cast<double>(stats.latency_sum) / static_cast<double>(stats.received);
+}
+
+// ----------------------------------------------------------------------------
+// Low traffic handoff: one message every 50 us. Compares the spin loop from
+// bench_spsc.cpp with a coroutine that suspends on pop_async() and is resumed on an
+// event loop thread.
+// ----------------------------------------------------------------------------
+
+static void BM_Async_LowTraffic_Spin(benchmark::State& state) {
+  loon::SpscQueue<int64_t, 1024> queue;
+  Stats stats;
+  int64_t consumer_cpu = 0;
+
+  std::thread consumer([&] {
+    const auto cpu_start = thread_cpu_ns();
+    int64_t sent_at;
+    for (;;) {
+      if (!queue.pop(sent_at))
+        continue;
+      if (sent_at == STOP)
+        break;
+      stats.latency_sum += now_ns() - sent_at;
+      ++stats.received;
+    }
+    consumer_cpu = thread_cpu_ns() - cpu_start;
+  });
+
+  const auto wall_start = now_ns();
+  for (auto _ : state) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    while (!queue.push(now_ns())) {
+    }
+  }
+  while (!queue.push(STOP)) {
+  }
+  consumer.join();
+  report(state, stats, consumer_cpu, now_ns() - wall_start);
+}
+BENCHMARK(BM_Async_LowTraffic_Spin)
+    ->Name("Async/LowTraffic/Spin")
+    ->Iterations(2000)
+    ->UseRealTime();
+
+static void BM_Async_LowTraffic_Coroutine(benchmark::State& state) {
+  HandleQueue handles;
+  loon::AsyncSpscQueue<int64_t, 1024, LoopExecutor> queue(LoopExecutor{&handles});
+  Stats stats;
+  int64_t consumer_cpu = 0;
+
+  std::thread loop([&] {
+    const auto cpu_start = thread_cpu_ns();
+    consume(queue, stats);
+    while (!stats.done) {
+      void* handle;
+      handles.pop_wait(handle);
+      std::coroutine_handle<>::from_address(handle).resume();
+    }
+    consumer_cpu = thread_cpu_ns() - cpu_start;
+  });
+
+  const auto wall_start = now_ns();
+  for (auto _ : state) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    while (!queue.push(now_ns())) {
+    }
+  }
+  while (!queue.push(STOP)) {
+  }
+  loop.join();
+  report(state, stats, consumer_cpu, now_ns() - wall_start);
+}
+BENCHMARK(BM_Async_LowTraffic_Coroutine)
+    ->Name("Async/LowTraffic/Coroutine")
+    ->Iterations(2000)
+    ->UseRealTime();
+
+// ----------------------------------------------------------------------------
+// Fast path: values already queued, so pop_async() never suspends. Compared with plain
+// push/pop to show what the wrapper adds when nobody waits.
+// ----------------------------------------------------------------------------
+
+static Detached drain(loon::AsyncSpscQueue<int64_t, 1024>& queue, int64_t count, int64_t& sum) {
+  for (int64_t i = 0; i < count; ++i) {
+    sum += co_await queue.pop_async();
+  }
+}
+
+static void BM_Async_FastPath_Coroutine(benchmark::State& state) {
+  loon::AsyncSpscQueue<int64_t, 1024> queue;
+  constexpr int64_t batch = 512;
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.push(i));
+    }
+    drain(queue, batch, sum);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_Async_FastPath_Coroutine)->Name("Async/FastPath/Coroutine");
+
+static void BM_Async_FastPath_Spsc(benchmark::State& state) {
+  loon::SpscQueue<int64_t, 1024> queue;
+  constexpr int64_t batch = 512;
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    for (int64_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.push(i));
+    }
+    int64_t value{};
+    for (int64_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.pop(value));
+      sum += value;
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * batch);
+}
+BENCHMARK(BM_Async_FastPath_Spsc)->Name("Async/FastPath/Spsc");
@@ -0,0 +1,112 @@
+#include <loon/broadcast.hpp>
+#include <loon/spsc.hpp>
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Message types
+// ----------------------------------------------------------------------------
+
+struct Msg64B {
+  int64_t id;
+  int64_t timestamp;
+  std::array<char, 48> payload;
+}; // 64 bytes
+
+// ----------------------------------------------------------------------------
+// Fan-out: one producer, state.range(0) consumers, every consumer reads every tick.
+// Threads yield when the ring is full or empty so oversubscribed machines still make
+// progress.
+// ----------------------------------------------------------------------------
+
+static void BM_BroadcastRing_FanOut(benchmark::State& state) {
+  const auto consumers = static_cast<size_t>(state.range(0));
+  constexpr int64_t count = 1 << 15;
+
+  for (auto _ : state) {
+    loon::BroadcastRing<Msg64B, 4096> ring;
+    std::vector<loon::BroadcastRing<Msg64B, 4096>::Consumer*> handles;
+    for (size_t c = 0; c < consumers; ++c) {
+      handles.push_back(&ring.add_consumer());
+    }
+
+    std::vector<std::thread> threads;
+    for (auto* handle : handles) {
+      threads.emplace_back([handle] {
+        for (int64_t i = 0; i < count; ++i) {
+          auto msg = handle->front();
+          while (!msg) {
+            std::this_thread::yield();
+            msg = handle->front();
+          }
+          benchmark::DoNotOptimize(msg->get().id);
+          handle->release();
+        }
+      });
+    }
+
+    Msg64B tick{};
+    for (int64_t i = 0; i < count; ++i) {
+      tick.id = i;
+      while (!ring.push(tick)) {
+        std::this_thread::yield();
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * count * static_cast<int64_t>(consumers));
+}
+BENCHMARK(BM_BroadcastRing_FanOut)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
+
+// Baseline: the producer copies every tick into one SpscQueue per consumer
+static void BM_SpscQueue_FanOut(benchmark::State& state) {
+  const auto consumers = static_cast<size_t>(state.range(0));
+  constexpr int64_t count = 1 << 15;
+  using Queue = loon::SpscQueue<Msg64B, 4096>;
+
+  for (auto _ : state) {
+    std::vector<std::unique_ptr<Queue>> queues;
+    for (size_t c = 0; c < consumers; ++c) {
+      queues.push_back(std::make_unique<Queue>());
+    }
+
+    std::vector<std::thread> threads;
+    for (auto& queue : queues) {
+      threads.emplace_back([&queue] {
+        for (int64_t i = 0; i < count; ++i) {
+          auto msg = queue->front();
+          while (!msg) {
+            std::this_thread::yield();
+            msg = queue->front();
+          }
+          benchmark::DoNotOptimize(msg->get().id);
+          queue->release();
+        }
+      });
+    }
+
+    Msg64B tick{};
+    for (int64_t i = 0; i < count; ++i) {
+      tick.id = i;
+      for (auto& queue : queues) {
+        while (!queue->push(tick)) {
+          std::this_thread::yield();
+        }
+      }
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * count * static_cast<int64_t>(consumers));
+}
+BENCHMARK(BM_SpscQueue_FanOut)->RangeMultiplier(2)->Range(1, 8)->UseRealTime();
@@ -0,0 +1,103 @@
+#include <loon/clock_cache.hpp>
+#include <loon/sharded_lru.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mutex_lru.hpp"
+#include "zipf.hpp"
+
+// Zipfian keys (s = 0.99) over 1M keys shared by every thread
+constexpr uint64_t KEY_SPACE = 1 << 20;
+constexpr uint32_t CAPACITY = 1 << 16;
+
+static const std::vector<uint64_t>& shared_keys() {
+  static const auto keys = zipf_keys(KEY_SPACE, 0.99, 1 << 20);
+  return keys;
+}
+
+// ----------------------------------------------------------------------------
+// Read-mostly workload: 95% get, 5% put. state.range(0) threads share one cache; each
+// walks its own stretch of the Zipfian key sequence.
+// ----------------------------------------------------------------------------
+
+template <typename Cache>
+static void BM_Cache_ReadMostly(benchmark::State& state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+  const auto& keys = shared_keys();
+  Cache cache(CAPACITY);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    cache.put(keys[i], keys[i]);
+  }
+
+  const size_t per_thread = count / threads;
+  size_t offset = 0;
+  for (auto _ : state) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      const size_t start = offset + t * per_thread;
+      workers.emplace_back([&cache, &keys, start, per_thread] {
+        for (size_t i = 0; i < per_thread; ++i) {
+          const auto key = keys[(start + i) & (keys.size() - 1)];
+          if (i % 20 == 0) {
+            cache.put(key, key);
+          } else {
+            auto value = cache.get(key);
+            benchmark::DoNotOptimize(value);
+          }
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    offset += count;
+  }
+  state.SetItemsProcessed(state.iterations() * per_thread * threads);
+}
+
+struct Sharded : loon::ShardedLRU<uint64_t, uint64_t> {
+  explicit Sharded(uint32_t capacity) : loon::ShardedLRU<uint64_t, uint64_t>(capacity, 64) {}
+};
+
+BENCHMARK(BM_Cache_ReadMostly<MutexLRU<uint64_t, uint64_t>>)
+    ->Name("ClockCache/ReadMostly/MutexLRU")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_Cache_ReadMostly<Sharded>)
+    ->Name("ClockCache/ReadMostly/ShardedLRU")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_Cache_ReadMostly<loon::ClockCache<uint64_t, uint64_t>>)
+    ->Name("ClockCache/ReadMostly/Clock")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+
+// ----------------------------------------------------------------------------
+// Single-threaded hit latency: what a reader pays for the seqlock and generation checks
+// ----------------------------------------------------------------------------
+
+template <typename Cache>
+static void BM_Cache_GetHit(benchmark::State& state) {
+  Cache cache(4096);
+  for (uint64_t i = 0; i < 4096; ++i) {
+    cache.put(i, i);
+  }
+
+  uint64_t key = 0;
+  for (auto _ : state) {
+    auto value = cache.get(key);
+    benchmark::DoNotOptimize(value);
+    key = (key + 1) & 4095;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Cache_GetHit<MutexLRU<uint64_t, uint64_t>>)->Name("ClockCache/GetHit/MutexLRU");
+BENCHMARK(BM_Cache_GetHit<loon::ClockCache<uint64_t, uint64_t>>)->Name("ClockCache/GetHit/Clock");
@@ -0,0 +1,114 @@
+#include <loon/fan_in.hpp>
+#include <loon/spsc.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// One consumer servicing state.range(0) per-client queues. Each iteration the clients
+// push a round of messages and the consumer drains everything:
+//   LowLoad  - one message into one random queue
+//   HighLoad - eight messages into every queue
+// The round-robin baseline calls pop() on every queue until all of them are empty.
+// Pushes run on the same thread, so the poller's producer-side fence is included.
+// ----------------------------------------------------------------------------
+
+constexpr size_t MAX_QUEUES = 512;
+constexpr size_t QUEUE_SIZE = 64;
+constexpr int64_t HIGH_LOAD_PER_QUEUE = 8;
+
+using Poller = loon::FanInPoller<int64_t, QUEUE_SIZE, MAX_QUEUES>;
+using Queue = loon::SpscQueue<int64_t, QUEUE_SIZE>;
+
+static void BM_FanIn_Poller_LowLoad(benchmark::State& state) {
+  const auto queues = static_cast<size_t>(state.range(0));
+  Poller poller;
+  std::vector<Poller::Producer*> producers;
+  for (size_t q = 0; q < queues; ++q) {
+    producers.push_back(&poller.add_producer());
+  }
+  std::mt19937 rng(42);
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(producers[rng() % queues]->push(1));
+    poller.poll([&](size_t, int64_t value) { sum += value; });
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FanIn_Poller_LowLoad)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_FanIn_RoundRobin_LowLoad(benchmark::State& state) {
+  const auto queues = static_cast<size_t>(state.range(0));
+  std::vector<std::unique_ptr<Queue>> clients;
+  for (size_t q = 0; q < queues; ++q) {
+    clients.push_back(std::make_unique<Queue>());
+  }
+  std::mt19937 rng(42);
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(clients[rng() % queues]->push(1));
+    int64_t value;
+    for (auto& client : clients) {
+      while (client->pop(value)) {
+        sum += value;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_FanIn_RoundRobin_LowLoad)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_FanIn_Poller_HighLoad(benchmark::State& state) {
+  const auto queues = static_cast<size_t>(state.range(0));
+  Poller poller;
+  std::vector<Poller::Producer*> producers;
+  for (size_t q = 0; q < queues; ++q) {
+    producers.push_back(&poller.add_producer());
+  }
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    for (auto* producer : producers) {
+      for (int64_t i = 0; i < HIGH_LOAD_PER_QUEUE; ++i) {
+        benchmark::DoNotOptimize(producer->push(i));
+      }
+    }
+    poller.poll([&](size_t, int64_t value) { sum += value; });
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * state.range(0) * HIGH_LOAD_PER_QUEUE);
+}
+BENCHMARK(BM_FanIn_Poller_HighLoad)->Arg(8)->Arg(64)->Arg(512);
+
+static void BM_FanIn_RoundRobin_HighLoad(benchmark::State& state) {
+  const auto queues = static_cast<size_t>(state.range(0));
+  std::vector<std::unique_ptr<Queue>> clients;
+  for (size_t q = 0; q < queues; ++q) {
+    clients.push_back(std::make_unique<Queue>());
+  }
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    for (auto& client : clients) {
+      for (int64_t i = 0; i < HIGH_LOAD_PER_QUEUE; ++i) {
+        benchmark::DoNotOptimize(client->push(i));
+      }
+    }
+    int64_t value;
+    for (auto& client : clients) {
+      while (client->pop(value)) {
+        sum += value;
+      }
+    }
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations() * state.range(0) * HIGH_LOAD_PER_QUEUE);
+}
+BENCHMARK(BM_FanIn_RoundRobin_HighLoad)->Arg(8)->Arg(64)->Arg(512);
@@ -0,0 +1,96 @@
+#include <loon/flight_recorder.hpp>
+#include <loon/ring_buffer.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Writer cost: state.range(0) threads each record EVENTS / threads 32-byte trace events
+// into a shared ring of CAPACITY entries, overwriting the oldest. Reported items are
+// events written per second across all threads.
+//   FlightRecorder - fetch_add to claim a slot, CAS on the slot stamp, copy
+//   MutexRing      - override-mode RingBuffer behind a std::mutex
+// ----------------------------------------------------------------------------
+
+struct TraceEvent {
+  uint64_t tsc;
+  uint32_t kind;
+  uint32_t thread;
+  uint64_t arg0;
+  uint64_t arg1;
+};
+
+constexpr size_t CAPACITY = 1 << 16;
+constexpr size_t EVENTS = 1 << 20;
+
+class MutexRing {
+ public:
+  void push(const TraceEvent& event) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    (void)ring_.push(event);
+  }
+
+ private:
+  std::mutex mutex_;
+  loon::RingBuffer<TraceEvent, CAPACITY> ring_{true};
+};
+
+template <typename Ring>
+static void run_writers(Ring& ring, size_t threads) {
+  const size_t per_thread = EVENTS / threads;
+  std::vector<std::thread> writers;
+  for (size_t t = 0; t < threads; ++t) {
+    writers.emplace_back([&ring, per_thread, t] {
+      for (size_t i = 0; i < per_thread; ++i) {
+        ring.push({i, 1, static_cast<uint32_t>(t), i, i});
+      }
+    });
+  }
+  for (auto& writer : writers) {
+    writer.join();
+  }
+}
+
+static void BM_FlightRecorder_Writers(benchmark::State& state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  auto recorder = std::make_unique<loon::FlightRecorder<TraceEvent, CAPACITY>>();
+  for (auto _ : state) {
+    run_writers(*recorder, threads);
+  }
+  state.counters["lost"] = static_cast<double>(recorder->lost());
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(EVENTS));
+}
+BENCHMARK(BM_FlightRecorder_Writers)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+static void BM_MutexRing_Writers(benchmark::State& state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  auto ring = std::make_unique<MutexRing>();
+  for (auto _ : state) {
+    run_writers(*ring, threads);
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(EVENTS));
+}
+BENCHMARK(BM_MutexRing_Writers)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+// ----------------------------------------------------------------------------
+// Snapshot cost: dump a full recorder to a temporary file
+// ----------------------------------------------------------------------------
+
+static void BM_FlightRecorder_Dump(benchmark::State& state) {
+  auto recorder = std::make_unique<loon::FlightRecorder<TraceEvent, CAPACITY>>();
+  run_writers(*recorder, 1);
+  std::FILE* file = std::tmpfile();
+  for (auto _ : state) {
+    std::rewind(file);
+    benchmark::DoNotOptimize(recorder->dump(fileno(file)));
+  }
+  std::fclose(file);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(CAPACITY));
+}
+BENCHMARK(BM_FlightRecorder_Dump);
@@ -0,0 +1,92 @@
+#include <loon/instrument.hpp>
+#include <loon/ring_buffer.hpp>
+#include <loon/spsc.hpp>
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+// Message types
+// ----------------------------------------------------------------------------
+
+struct Msg64B {
+  int64_t id;
+  int64_t timestamp;
+  std::array<char, 48> payload;
+}; // 64 bytes
+
+// ----------------------------------------------------------------------------
+// Round trips with instrumentation Off (the default NoInstrumentation policy, the same
+// type as a plain SpscQueue/RingBuffer) and On (DwellInstrumentation: a TSC read per
+// push and pop plus a histogram increment).
+// ----------------------------------------------------------------------------
+
+template <typename Instrument>
+static void BM_Instrument_SpscQueue_RoundTrip(benchmark::State& state) {
+  loon::SpscQueue<Msg64B, 1024, Instrument> queue;
+  Msg64B msg{};
+  Msg64B out{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.push(msg));
+    benchmark::DoNotOptimize(queue.pop(out));
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_Instrument_SpscQueue_RoundTrip<loon::NoInstrumentation>)
+    ->Name("Instrument/SpscQueue/RoundTrip/Off");
+BENCHMARK(BM_Instrument_SpscQueue_RoundTrip<loon::DwellInstrumentation>)
+    ->Name("Instrument/SpscQueue/RoundTrip/On");
+
+template <typename Instrument>
+static void BM_Instrument_RingBuffer_RoundTrip(benchmark::State& state) {
+  loon::RingBuffer<Msg64B, 1024, Instrument> ring;
+  Msg64B msg{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ring.push(msg));
+    auto out = ring.pop();
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_Instrument_RingBuffer_RoundTrip<loon::NoInstrumentation>)
+    ->Name("Instrument/RingBuffer/RoundTrip/Off");
+BENCHMARK(BM_Instrument_RingBuffer_RoundTrip<loon::DwellInstrumentation>)
+    ->Name("Instrument/RingBuffer/RoundTrip/On");
+
+// ----------------------------------------------------------------------------
+// Producer/consumer threads streaming 65536 messages. Threads yield when the queue is
+// full or empty so oversubscribed machines still make progress.
+// ----------------------------------------------------------------------------
+
+template <typename Instrument>
+static void BM_Instrument_SpscQueue_ProducerConsumer(benchmark::State& state) {
+  constexpr int64_t count = 1 << 16;
+  for (auto _ : state) {
+    loon::SpscQueue<int64_t, 4096, Instrument> queue;
+    std::thread consumer([&] {
+      int64_t value;
+      for (int64_t i = 0; i < count; ++i) {
+        while (!queue.pop(value)) {
+          std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(value);
+      }
+    });
+    for (int64_t i = 0; i < count; ++i) {
+      while (!queue.push(i)) {
+        std::this_thread::yield();
+      }
+    }
+    consumer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+}
+BENCHMARK(BM_Instrument_SpscQueue_ProducerConsumer<loon::NoInstrumentation>)
+    ->Name("Instrument/SpscQueue/ProducerConsumer/Off")
+    ->UseRealTime();
+BENCHMARK(BM_Instrument_SpscQueue_ProducerConsumer<loon::DwellInstrumentation>)
+    ->Name("Instrument/SpscQueue/ProducerConsumer/On")
+    ->UseRealTime();
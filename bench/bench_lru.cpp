@@ -6,6 +6,9 @@
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <vector>
+
+#include "unordered_lru.hpp"
 
 // ----------------------------------------------------------------------------
 // Value types of different sizes
@@ -284,3 +287,79 @@ static void BM_LRU_Random_Access(benchmark::State& state) {
   state.SetItemsProcessed(state.iterations());
 }
 BENCHMARK(BM_LRU_Random_Access)->Range(64, 4096);
+
+// ----------------------------------------------------------------------------
+// Embedded open-addressing index vs the previous std::unordered_map index
+// (UnorderedMapLRU), with random keys so neither benefits from prefetching. At 16M
+// entries both working sets are several hundred MB, far beyond the last-level cache.
+// ----------------------------------------------------------------------------
+
+// Random hit keys, generated before timing
+static std::vector<uint32_t> random_keys(size_t count, size_t n) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint32_t> dist(0, static_cast<uint32_t>(count - 1));
+  std::vector<uint32_t> keys(n);
+  for (auto& key : keys) {
+    key = dist(rng);
+  }
+  return keys;
+}
+
+template <typename Cache>
+static void BM_Index_GetHit(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  Cache cache(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; ++i) {
+    cache.put(static_cast<uint32_t>(i), static_cast<uint32_t>(i));
+  }
+  const auto keys = random_keys(count, 1 << 20);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    auto val = cache.get(keys[i++ & (keys.size() - 1)]);
+    benchmark::DoNotOptimize(val);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Index_GetHit<loon::LRU<uint32_t, uint32_t>>)
+    ->Name("LRU/Index/GetHit/Flat")
+    ->Arg(4096)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+BENCHMARK(BM_Index_GetHit<UnorderedMapLRU<uint32_t, uint32_t>>)
+    ->Name("LRU/Index/GetHit/UnorderedMap")
+    ->Arg(4096)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+
+// Half the keys miss and are inserted, evicting the LRU entry
+template <typename Cache>
+static void BM_Index_GetOrPut(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+  Cache cache(static_cast<uint32_t>(count));
+  for (size_t i = 0; i < count; ++i) {
+    cache.put(static_cast<uint32_t>(i), static_cast<uint32_t>(i));
+  }
+  const auto keys = random_keys(count * 2, 1 << 20);
+
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto key = keys[i++ & (keys.size() - 1)];
+    auto val = cache.get(key);
+    if (!val) {
+      cache.put(key, key);
+    }
+    benchmark::DoNotOptimize(val);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Index_GetOrPut<loon::LRU<uint32_t, uint32_t>>)
+    ->Name("LRU/Index/GetOrPut/Flat")
+    ->Arg(4096)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
+BENCHMARK(BM_Index_GetOrPut<UnorderedMapLRU<uint32_t, uint32_t>>)
+    ->Name("LRU/Index/GetOrPut/UnorderedMap")
+    ->Arg(4096)
+    ->Arg(1 << 20)
+    ->Arg(1 << 24);
@@ -0,0 +1,140 @@
+#include <loon/mirrored_ring.hpp>
+#include <loon/ring_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+
+// ----------------------------------------------------------------------------
+// Variable-length records - a 4-byte length followed by that many payload bytes - are
+// streamed through a one-page byte ring, so records regularly straddle the wrap point.
+// Each iteration the producer appends half a ring of records and the consumer decodes
+// every complete record in place:
+//   Mirrored - one contiguous readable span, records are decoded where they lie
+//   TwoSpan  - RingBuffer::readable_spans(); a record crossing the wrap point is first
+//              stitched together into a scratch buffer
+// Payloads are uniform between MIN_PAYLOAD and state.range(0) bytes, so larger records
+// straddle more often and cost more to stitch.
+// ----------------------------------------------------------------------------
+
+constexpr size_t RING_BYTES = 4096;
+constexpr size_t MIN_PAYLOAD = 16;
+constexpr size_t MAX_PAYLOAD = 1024;
+
+using ByteRing = loon::RingBuffer<std::byte, RING_BYTES>;
+
+// Builds one batch of encoded records, about half a ring, with payload sizes in
+// [MIN_PAYLOAD, max_payload]
+static std::vector<std::byte> make_batch(size_t max_payload) {
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<uint32_t> length(static_cast<uint32_t>(MIN_PAYLOAD),
+                                                 static_cast<uint32_t>(max_payload));
+  std::vector<std::byte> batch;
+  while (true) {
+    const uint32_t n = length(rng);
+    if (batch.size() + sizeof(n) + n > RING_BYTES / 2)
+      break;
+    const auto* header = reinterpret_cast<const std::byte*>(&n);
+    batch.insert(batch.end(), header, header + sizeof(n));
+    for (uint32_t i = 0; i < n; ++i) {
+      batch.push_back(static_cast<std::byte>(rng()));
+    }
+  }
+  return batch;
+}
+
+// Stand-in for a decoder: reads fixed fields from both ends of the payload
+static uint64_t decode(const std::byte* payload, uint32_t length) {
+  uint64_t head;
+  uint64_t tail;
+  std::memcpy(&head, payload, sizeof(head));
+  std::memcpy(&tail, payload + length - sizeof(tail), sizeof(tail));
+  return head ^ tail;
+}
+
+// Parses complete records from one contiguous span; returns the bytes consumed
+static size_t parse(std::span<const std::byte> bytes, uint64_t& checksum, size_t& records) {
+  size_t offset = 0;
+  uint32_t length;
+  while (bytes.size() - offset >= sizeof(length)) {
+    std::memcpy(&length, bytes.data() + offset, sizeof(length));
+    if (bytes.size() - offset - sizeof(length) < length)
+      break;
+    checksum += decode(bytes.data() + offset + sizeof(length), length);
+    offset += sizeof(length) + length;
+    ++records;
+  }
+  return offset;
+}
+
+// Parses complete records from two spans, stitching any record split between them
+static size_t parse(std::span<const std::byte> first, std::span<const std::byte> second,
+                    uint64_t& checksum, size_t& records) {
+  std::array<std::byte, sizeof(uint32_t) + MAX_PAYLOAD> scratch;
+  size_t offset = parse(first, checksum, records);
+  const size_t tail = first.size() - offset;
+  if (tail > 0 && !second.empty()) {
+    uint32_t length;
+    if (tail + second.size() < sizeof(length))
+      return offset;
+    const size_t header_head = std::min(tail, sizeof(length));
+    std::memcpy(&length, first.data() + offset, header_head);
+    std::memcpy(reinterpret_cast<std::byte*>(&length) + header_head, second.data(),
+                sizeof(length) - header_head);
+    const size_t record = sizeof(length) + length;
+    if (tail + second.size() < record)
+      return offset;
+    std::memcpy(scratch.data(), first.data() + offset, tail);
+    std::memcpy(scratch.data() + tail, second.data(), record - tail);
+    checksum += decode(scratch.data() + sizeof(length), length);
+    ++records;
+    offset += record;
+    return offset + parse(second.subspan(record - tail), checksum, records);
+  }
+  return offset + (tail == 0 ? parse(second, checksum, records) : 0);
+}
+
+static void BM_MirroredRing_Parse(benchmark::State& state) {
+  const auto batch = make_batch(static_cast<size_t>(state.range(0)));
+  loon::MirroredRingBuffer<std::byte> ring(RING_BYTES);
+  uint64_t checksum = 0;
+  size_t records = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ring.push_n(batch));
+    ring.consume(parse(ring.readable_span(), checksum, records));
+  }
+  benchmark::DoNotOptimize(checksum);
+  state.SetItemsProcessed(static_cast<int64_t>(records));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(BM_MirroredRing_Parse)->Name("MirroredRing/Parse")->Arg(64)->Arg(256)->Arg(1024);
+
+static void BM_TwoSpanRing_Parse(benchmark::State& state) {
+  const auto batch = make_batch(static_cast<size_t>(state.range(0)));
+  auto ring = std::make_unique<ByteRing>();
+  uint64_t checksum = 0;
+  size_t records = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ring->push_n(batch));
+    auto [first, second] = std::as_const(*ring).readable_spans();
+    ring->consume(parse(first, second, checksum, records));
+  }
+  benchmark::DoNotOptimize(checksum);
+  state.SetItemsProcessed(static_cast<int64_t>(records));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(BM_TwoSpanRing_Parse)->Name("TwoSpanRing/Parse")->Arg(64)->Arg(256)->Arg(1024);
+
+#endif // __linux__
@@ -0,0 +1,89 @@
+#include <loon/mpmc.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "mutex_queue.hpp"
+
+// ----------------------------------------------------------------------------
+// Single-threaded benchmarks (baseline latency)
+// ----------------------------------------------------------------------------
+
+static void BM_MpmcQueue_PushPop_Interleaved(benchmark::State& state) {
+  loon::MpmcQueue<int, 1024> queue;
+  int value = 0;
+  int out{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.push(value++));
+    benchmark::DoNotOptimize(queue.pop(out));
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_MpmcQueue_PushPop_Interleaved);
+
+// ----------------------------------------------------------------------------
+// Thread scaling: state.range(0) producers and state.range(0) consumers move a fixed
+// number of items. Threads yield when the queue is full or empty so oversubscribed
+// machines still make progress.
+// ----------------------------------------------------------------------------
+
+template <typename Queue>
+static void run_mpmc(Queue& queue, size_t threads, size_t count) {
+  std::atomic<size_t> consumed{0};
+  std::vector<std::thread> workers;
+  const size_t per_producer = count / threads;
+
+  for (size_t p = 0; p < threads; ++p) {
+    workers.emplace_back([&] {
+      for (size_t i = 0; i < per_producer; ++i) {
+        while (!queue.push(static_cast<int>(i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (size_t c = 0; c < threads; ++c) {
+    workers.emplace_back([&] {
+      int value;
+      while (consumed.load(std::memory_order_relaxed) < per_producer * threads) {
+        if (queue.pop(value)) {
+          benchmark::DoNotOptimize(value);
+          consumed.fetch_add(1, std::memory_order_relaxed);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+static void BM_MpmcQueue_Scaling(benchmark::State& state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+
+  for (auto _ : state) {
+    loon::MpmcQueue<int, 4096> queue;
+    run_mpmc(queue, threads, count);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_MpmcQueue_Scaling)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+static void BM_MutexQueue_Scaling(benchmark::State& state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+
+  for (auto _ : state) {
+    MutexQueue<int> queue(4096);
+    run_mpmc(queue, threads, count);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_MutexQueue_Scaling)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
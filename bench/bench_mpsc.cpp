@@ -0,0 +1,94 @@
+#include <loon/mpmc.hpp>
+#include <loon/mpsc.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "mutex_queue.hpp"
+
+// ----------------------------------------------------------------------------
+// Single-threaded benchmarks (baseline latency)
+// ----------------------------------------------------------------------------
+
+static void BM_MpscQueue_PushPop_Interleaved(benchmark::State& state) {
+  loon::MpscQueue<int, 1024> queue;
+  int value = 0;
+  int out{};
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.push(value++));
+    benchmark::DoNotOptimize(queue.pop(out));
+    benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_MpscQueue_PushPop_Interleaved);
+
+// ----------------------------------------------------------------------------
+// Fan-in scaling: state.range(0) producers feed one consumer (the main thread).
+// Threads yield when the queue is full or empty so oversubscribed machines still make
+// progress.
+// ----------------------------------------------------------------------------
+
+template <typename Queue>
+static void run_fan_in(Queue& queue, size_t producers, size_t count) {
+  const size_t per_producer = count / producers;
+  std::vector<std::thread> workers;
+  for (size_t p = 0; p < producers; ++p) {
+    workers.emplace_back([&] {
+      for (size_t i = 0; i < per_producer; ++i) {
+        while (!queue.push(static_cast<int>(i))) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  int value;
+  for (size_t consumed = 0; consumed < per_producer * producers;) {
+    if (queue.pop(value)) {
+      benchmark::DoNotOptimize(value);
+      ++consumed;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+static void BM_MpscQueue_FanIn(benchmark::State& state) {
+  const auto producers = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+  for (auto _ : state) {
+    loon::MpscQueue<int, 4096> queue;
+    run_fan_in(queue, producers, count);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_MpscQueue_FanIn)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+// General MPMC queue on the same workload: pays a CAS on the consumer side
+static void BM_MpmcQueue_FanIn(benchmark::State& state) {
+  const auto producers = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+  for (auto _ : state) {
+    loon::MpmcQueue<int, 4096> queue;
+    run_fan_in(queue, producers, count);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_MpmcQueue_FanIn)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+static void BM_MutexQueue_FanIn(benchmark::State& state) {
+  const auto producers = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+  for (auto _ : state) {
+    MutexQueue<int> queue(4096);
+    run_fan_in(queue, producers, count);
+  }
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_MutexQueue_FanIn)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
@@ -0,0 +1,123 @@
+#include <loon/ring_buffer.hpp>
+#include <loon/spsc.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Payloads that own heap memory. Elements are constructed in place on push and
+// destroyed on pop, so a moved-in std::string or unique_ptr hands over its buffer
+// instead of allocating a copy, and move-only types can be queued at all.
+// ----------------------------------------------------------------------------
+
+// Long enough to defeat the small-string optimization
+static const std::string PAYLOAD(64, 'x');
+
+// The producer builds a fresh string per message, as a real one would, and moves it in
+static void BM_SpscQueue_String_Move(benchmark::State& state) {
+  loon::SpscQueue<std::string, 1024> queue;
+
+  for (auto _ : state) {
+    std::string msg = PAYLOAD;
+    benchmark::DoNotOptimize(queue.push(std::move(msg)));
+    auto out = queue.pop();
+    benchmark::DoNotOptimize(out->data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscQueue_String_Move)->Name("SpscQueue/String/Move");
+
+// Same producer, but the string is copied in and out as the queue used to require
+static void BM_SpscQueue_String_BuildAndCopy(benchmark::State& state) {
+  loon::SpscQueue<std::string, 1024> queue;
+  std::string out;
+
+  for (auto _ : state) {
+    std::string msg = PAYLOAD;
+    benchmark::DoNotOptimize(queue.push(msg));
+    benchmark::DoNotOptimize(queue.pop(out));
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscQueue_String_BuildAndCopy)->Name("SpscQueue/String/BuildAndCopy");
+
+static void BM_SpscQueue_UniquePtr(benchmark::State& state) {
+  loon::SpscQueue<std::unique_ptr<int64_t>, 1024> queue;
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.push(std::make_unique<int64_t>(1)));
+    auto out = queue.pop();
+    sum += **out;
+  }
+  benchmark::DoNotOptimize(sum);
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscQueue_UniquePtr)->Name("SpscQueue/UniquePtr");
+
+static void BM_RingBuffer_String_Copy(benchmark::State& state) {
+  loon::RingBuffer<std::string, 1024> buffer;
+
+  for (auto _ : state) {
+    std::string msg = PAYLOAD;
+    benchmark::DoNotOptimize(buffer.push(msg));
+    auto out = buffer.pop();
+    benchmark::DoNotOptimize(out->data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBuffer_String_Copy)->Name("RingBuffer/String/BuildAndCopy");
+
+static void BM_RingBuffer_String_Move(benchmark::State& state) {
+  loon::RingBuffer<std::string, 1024> buffer;
+
+  for (auto _ : state) {
+    std::string msg = PAYLOAD;
+    benchmark::DoNotOptimize(buffer.push(std::move(msg)));
+    auto out = buffer.pop();
+    benchmark::DoNotOptimize(out->data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBuffer_String_Move)->Name("RingBuffer/String/Move");
+
+static void BM_RingBuffer_UniquePtr_Override(benchmark::State& state) {
+  loon::RingBuffer<std::unique_ptr<int64_t>, 256> buffer(true);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buffer.emplace(std::make_unique<int64_t>(1)));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RingBuffer_UniquePtr_Override)->Name("RingBuffer/UniquePtr/Override");
+
+// ----------------------------------------------------------------------------
+// Startup cost - constructing a queue no longer constructs its slots. The baseline
+// value-initializes the same number of strings, as the old runtime-capacity storage did.
+// ----------------------------------------------------------------------------
+
+static void BM_SpscQueue_Construct(benchmark::State& state) {
+  const auto capacity = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    loon::SpscQueue<std::string, loon::DYNAMIC_CAPACITY> queue(capacity);
+    benchmark::DoNotOptimize(&queue);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SpscQueue_Construct)->Name("SpscQueue/Construct/String")->Range(1 << 10, 1 << 18);
+
+static void BM_ValueInitializedSlots_Construct(benchmark::State& state) {
+  const auto capacity = static_cast<size_t>(state.range(0));
+  for (auto _ : state) {
+    std::vector<std::string> slots(capacity);
+    benchmark::DoNotOptimize(slots.data());
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ValueInitializedSlots_Construct)
+    ->Name("ValueInitializedSlots/Construct/String")
+    ->Range(1 << 10, 1 << 18);
@@ -0,0 +1,87 @@
+#include <loon/persistent_ring.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+// Journals are created under std::filesystem::temp_directory_path(). If that is a tmpfs,
+// msync returns immediately and the flush policies only show their CPU cost; point
+// TMPDIR at a disk-backed directory to measure write-back.
+// ----------------------------------------------------------------------------
+
+struct Event {
+  uint64_t tsc;
+  uint64_t order_id;
+  double price;
+  double qty;
+  uint32_t kind;
+  uint32_t venue;
+  uint64_t flags;
+}; // 48 bytes, so a journal record is 64
+
+static std::string journal_path(const char* tag) {
+  return (std::filesystem::temp_directory_path() /
+          ("loon_bench_" + std::string(tag) + "_" + std::to_string(::getpid()) + ".ring"))
+      .string();
+}
+
+// ----------------------------------------------------------------------------
+// Append throughput: override-mode journal of 64K records, flushed with msync(MS_SYNC)
+// every state.range(0) pushes (0 = never, left to kernel write-back)
+// ----------------------------------------------------------------------------
+
+static void BM_PersistentRing_Append(benchmark::State& state) {
+  const auto path = journal_path("append");
+  {
+    loon::PersistentRingBuffer<Event, 1 << 16> journal(path, true,
+                                                       static_cast<size_t>(state.range(0)));
+    Event event{};
+    for (auto _ : state) {
+      ++event.tsc;
+      benchmark::DoNotOptimize(journal.push(event));
+    }
+  }
+  std::filesystem::remove(path);
+  state.SetItemsProcessed(state.iterations());
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(sizeof(Event)));
+}
+BENCHMARK(BM_PersistentRing_Append)->Arg(0)->Arg(4096)->Arg(64)->Arg(1);
+
+// ----------------------------------------------------------------------------
+// Recovery time: opening a full 1 GiB journal (16M records) validates every checksum.
+// The file stays in the page cache, so this measures validation, not disk reads.
+// ----------------------------------------------------------------------------
+
+constexpr size_t RECOVERY_RECORDS = (size_t{1} << 30) / 64;
+using LargeJournal = loon::PersistentRingBuffer<Event, RECOVERY_RECORDS>;
+
+// Fills the journal once per process and removes it at exit
+struct RecoveryFile {
+  std::string path = journal_path("recovery");
+
+  RecoveryFile() {
+    LargeJournal journal(path, true);
+    Event event{};
+    for (size_t i = 0; i < RECOVERY_RECORDS; ++i) {
+      event.tsc = i;
+      (void)journal.push(event);
+    }
+  }
+  ~RecoveryFile() { std::filesystem::remove(path); }
+};
+
+static void BM_PersistentRing_Recover1GiB(benchmark::State& state) {
+  static const RecoveryFile file;
+  for (auto _ : state) {
+    LargeJournal journal(file.path, true);
+    benchmark::DoNotOptimize(journal.recovered());
+  }
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(RECOVERY_RECORDS));
+  state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(size_t{1} << 30));
+}
+BENCHMARK(BM_PersistentRing_Recover1GiB)->Unit(benchmark::kMillisecond);
@@ -1,9 +1,12 @@
 #include <loon/ring_buffer.hpp>
 
+#include <algorithm>
 #include <array>
 #include <benchmark/benchmark.h>
 #include <cstdint>
+#include <numeric>
 #include <queue>
+#include <vector>
 
 // ----------------------------------------------------------------------------
 // Message types of different sizes
@@ -35,7 +38,7 @@ static void BM_RingBuffer_Push(benchmark::State& state) {
   for (auto _ : state) {
     loon::RingBuffer<int, 4096> buffer;
     for (size_t i = 0; i < size; ++i) {
-      buffer.push(static_cast<int>(i));
+      benchmark::DoNotOptimize(buffer.push(static_cast<int>(i)));
     }
     benchmark::DoNotOptimize(buffer);
   }
@@ -49,7 +52,7 @@ static void BM_RingBuffer_Pop(benchmark::State& state) {
     state.PauseTiming();
     loon::RingBuffer<int, 4096> buffer;
     for (size_t i = 0; i < size; ++i) {
-      buffer.push(static_cast<int>(i));
+      benchmark::DoNotOptimize(buffer.push(static_cast<int>(i)));
     }
     state.ResumeTiming();
 
@@ -66,7 +69,7 @@ static void BM_RingBuffer_PushPop_Interleaved(benchmark::State& state) {
   loon::RingBuffer<int, 1024> buffer;
   int value = 0;
   for (auto _ : state) {
-    buffer.push(value++);
+    benchmark::DoNotOptimize(buffer.push(value++));
     auto val = buffer.pop();
     benchmark::DoNotOptimize(val);
   }
@@ -78,18 +81,39 @@ static void BM_RingBuffer_Override(benchmark::State& state) {
   loon::RingBuffer<int, 256> buffer(true); // override mode
   // Pre-fill to full
   for (size_t i = 0; i < 256; ++i) {
-    buffer.push(static_cast<int>(i));
+    benchmark::DoNotOptimize(buffer.push(static_cast<int>(i)));
   }
 
   int value = 0;
   for (auto _ : state) {
-    buffer.push(value++);
+    benchmark::DoNotOptimize(buffer.push(value++));
     benchmark::DoNotOptimize(buffer);
   }
   state.SetItemsProcessed(state.iterations());
 }
 BENCHMARK(BM_RingBuffer_Override);
 
+// Power-of-two capacity wraps with a mask, other capacities with compare-and-reset
+template <size_t N>
+static void BM_RingBuffer_Capacity(benchmark::State& state) {
+  loon::RingBuffer<int, N> buffer;
+  constexpr size_t batch = 1000;
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(buffer.push(static_cast<int>(i)));
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      auto val = buffer.pop();
+      benchmark::DoNotOptimize(val);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch * 2);
+}
+
+BENCHMARK(BM_RingBuffer_Capacity<1000>)->Name("RingBuffer/Capacity/1000");
+BENCHMARK(BM_RingBuffer_Capacity<1024>)->Name("RingBuffer/Capacity/1024");
+
 // ----------------------------------------------------------------------------
 // std::queue comparison (baseline)
 // ----------------------------------------------------------------------------
@@ -151,7 +175,7 @@ static void BM_RingBuffer_RoundTrip(benchmark::State& state) {
   T msg{};
 
   for (auto _ : state) {
-    buffer.push(msg);
+    benchmark::DoNotOptimize(buffer.push(msg));
     auto val = buffer.pop();
     benchmark::DoNotOptimize(val);
   }
@@ -173,7 +197,7 @@ static void BM_RingBuffer_Throughput(benchmark::State& state) {
 
   for (auto _ : state) {
     for (size_t i = 0; i < batch; ++i) {
-      buffer.push(msg);
+      benchmark::DoNotOptimize(buffer.push(msg));
     }
     for (size_t i = 0; i < batch; ++i) {
       auto val = buffer.pop();
@@ -189,6 +213,62 @@ BENCHMARK(BM_RingBuffer_Throughput<Msg16B>)->Name("RingBuffer/Throughput/16B");
 BENCHMARK(BM_RingBuffer_Throughput<Msg64B>)->Name("RingBuffer/Throughput/64B");
 BENCHMARK(BM_RingBuffer_Throughput<Msg256B>)->Name("RingBuffer/Throughput/256B");
 
+// Same traffic as BM_RingBuffer_Throughput, moved with one push_n and one pop_n per batch
+template <typename T>
+static void BM_RingBuffer_Throughput_Bulk(benchmark::State& state) {
+  loon::RingBuffer<T, 4096> buffer;
+  constexpr size_t batch = 1000;
+  std::vector<T> in(batch);
+  std::vector<T> out(batch);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(buffer.push_n(in));
+    benchmark::DoNotOptimize(buffer.pop_n(out));
+    benchmark::DoNotOptimize(out.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch * 2);
+  state.SetBytesProcessed(state.iterations() * batch * sizeof(T) * 2);
+}
+
+BENCHMARK(BM_RingBuffer_Throughput_Bulk<Msg16B>)->Name("RingBuffer/Throughput/Bulk/16B");
+BENCHMARK(BM_RingBuffer_Throughput_Bulk<Msg64B>)->Name("RingBuffer/Throughput/Bulk/64B");
+BENCHMARK(BM_RingBuffer_Throughput_Bulk<Msg256B>)->Name("RingBuffer/Throughput/Bulk/256B");
+
+// Zero-copy: the producer fills writable_spans() in place and the consumer reads
+// readable_spans() in place, as a decoder handed the whole readable region would
+template <typename T>
+static void BM_RingBuffer_Throughput_Spans(benchmark::State& state) {
+  loon::RingBuffer<T, 4096> buffer;
+  constexpr size_t batch = 1000;
+  int64_t id = 0;
+  int64_t sum = 0;
+
+  for (auto _ : state) {
+    size_t produced = 0;
+    for (auto span : buffer.writable_spans()) {
+      for (size_t i = 0; i < span.size() && produced < batch; ++i, ++produced) {
+        span[i].id = id++;
+      }
+    }
+    buffer.produce(produced);
+    for (auto span : buffer.readable_spans()) {
+      for (const auto& msg : span) {
+        sum += msg.id;
+      }
+    }
+    buffer.consume(buffer.size());
+  }
+  benchmark::DoNotOptimize(sum);
+
+  state.SetItemsProcessed(state.iterations() * batch * 2);
+  state.SetBytesProcessed(state.iterations() * batch * sizeof(T) * 2);
+}
+
+BENCHMARK(BM_RingBuffer_Throughput_Spans<Msg16B>)->Name("RingBuffer/Throughput/Spans/16B");
+BENCHMARK(BM_RingBuffer_Throughput_Spans<Msg64B>)->Name("RingBuffer/Throughput/Spans/64B");
+BENCHMARK(BM_RingBuffer_Throughput_Spans<Msg256B>)->Name("RingBuffer/Throughput/Spans/256B");
+
 // std::queue comparison for message sizes
 template <typename T>
 static void BM_StdQueue_RoundTrip(benchmark::State& state) {
@@ -209,3 +289,108 @@ static void BM_StdQueue_RoundTrip(benchmark::State& state) {
 BENCHMARK(BM_StdQueue_RoundTrip<Msg16B>)->Name("std::queue/RoundTrip/16B");
 BENCHMARK(BM_StdQueue_RoundTrip<Msg64B>)->Name("std::queue/RoundTrip/64B");
 BENCHMARK(BM_StdQueue_RoundTrip<Msg256B>)->Name("std::queue/RoundTrip/256B");
+
+// ----------------------------------------------------------------------------
+// Sliding window benchmarks - each iteration pushes one sample into a full
+// override-mode buffer, then scans the whole window:
+//   Iterators    - std::accumulate / std::ranges::find over begin()..end() in place
+//   Spans        - the same over readable_spans(), for reference
+//   PopReinsert  - pop every element and push it back, the only option without iterators
+// ----------------------------------------------------------------------------
+
+template <size_t N>
+static loon::RingBuffer<int64_t, N> make_window() {
+  loon::RingBuffer<int64_t, N> window(true);
+  for (size_t i = 0; i < N; ++i) {
+    benchmark::DoNotOptimize(window.push(static_cast<int64_t>(i)));
+  }
+  return window;
+}
+
+template <size_t N>
+static void BM_RingBuffer_WindowSum_Iterators(benchmark::State& state) {
+  auto window = make_window<N>();
+  int64_t sample = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(window.push(sample++));
+    benchmark::DoNotOptimize(std::accumulate(window.begin(), window.end(), int64_t{0}));
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <size_t N>
+static void BM_RingBuffer_WindowSum_Spans(benchmark::State& state) {
+  auto window = make_window<N>();
+  int64_t sample = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(window.push(sample++));
+    int64_t sum = 0;
+    for (auto span : window.readable_spans()) {
+      sum = std::accumulate(span.begin(), span.end(), sum);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <size_t N>
+static void BM_RingBuffer_WindowSum_PopReinsert(benchmark::State& state) {
+  auto window = make_window<N>();
+  int64_t sample = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(window.push(sample++));
+    int64_t sum = 0;
+    for (size_t i = 0; i < N; ++i) {
+      const int64_t value = *window.pop();
+      sum += value;
+      benchmark::DoNotOptimize(window.push(value));
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+// Searches for a value that is never in the window, so every scan is a full pass
+template <size_t N>
+static void BM_RingBuffer_WindowFind_Iterators(benchmark::State& state) {
+  auto window = make_window<N>();
+  int64_t sample = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(window.push(sample++));
+    benchmark::DoNotOptimize(std::ranges::find(window, -1));
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <size_t N>
+static void BM_RingBuffer_WindowFind_PopReinsert(benchmark::State& state) {
+  auto window = make_window<N>();
+  int64_t sample = 0;
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(window.push(sample++));
+    bool found = false;
+    for (size_t i = 0; i < N; ++i) {
+      const int64_t value = *window.pop();
+      found |= value == -1;
+      benchmark::DoNotOptimize(window.push(value));
+    }
+    benchmark::DoNotOptimize(found);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(BM_RingBuffer_WindowSum_Iterators<64>)->Name("RingBuffer/WindowSum/Iterators/64");
+BENCHMARK(BM_RingBuffer_WindowSum_Spans<64>)->Name("RingBuffer/WindowSum/Spans/64");
+BENCHMARK(BM_RingBuffer_WindowSum_PopReinsert<64>)->Name("RingBuffer/WindowSum/PopReinsert/64");
+BENCHMARK(BM_RingBuffer_WindowSum_Iterators<1024>)->Name("RingBuffer/WindowSum/Iterators/1024");
+BENCHMARK(BM_RingBuffer_WindowSum_Spans<1024>)->Name("RingBuffer/WindowSum/Spans/1024");
+BENCHMARK(BM_RingBuffer_WindowSum_PopReinsert<1024>)
+    ->Name("RingBuffer/WindowSum/PopReinsert/1024");
+BENCHMARK(BM_RingBuffer_WindowFind_Iterators<1024>)->Name("RingBuffer/WindowFind/Iterators/1024");
+BENCHMARK(BM_RingBuffer_WindowFind_PopReinsert<1024>)
+    ->Name("RingBuffer/WindowFind/PopReinsert/1024");
@@ -0,0 +1,117 @@
+#include <loon/ring_buffer.hpp>
+#include <loon/rolling.hpp>
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <utility>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Rolling statistics over the last N ticks. Every iteration pushes one price and reads
+// sum, mean, standard deviation, min and max:
+//   Incremental - RollingWindow, O(1) per tick
+//   Naive       - RingBuffer in override mode, rescanning both readable spans per tick
+//   Recompute   - the cost of one RollingWindow::recompute() drift correction
+// ----------------------------------------------------------------------------
+
+struct Stats {
+  double sum;
+  double mean;
+  double stddev;
+  double min;
+  double max;
+};
+
+static std::vector<double> make_prices() {
+  std::mt19937 rng(42);
+  std::normal_distribution<double> step(0.0, 0.01);
+  std::vector<double> prices(4096);
+  double price = 100.0;
+  for (auto& p : prices) {
+    p = price += step(rng);
+  }
+  return prices;
+}
+
+template <size_t N>
+static void BM_Rolling_Incremental(benchmark::State& state) {
+  const auto prices = make_prices();
+  auto window = std::make_unique<loon::RollingWindow<double, N>>();
+  size_t tick = 0;
+  for (size_t i = 0; i < N; ++i) {
+    window->push(prices[tick++ % prices.size()]);
+  }
+
+  for (auto _ : state) {
+    window->push(prices[tick++ % prices.size()]);
+    Stats stats{window->sum(), window->mean(), window->stddev(), window->min(), window->max()};
+    benchmark::DoNotOptimize(stats);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <size_t N>
+static void BM_Rolling_Naive(benchmark::State& state) {
+  const auto prices = make_prices();
+  auto window = std::make_unique<loon::RingBuffer<double, N>>(true);
+  size_t tick = 0;
+  for (size_t i = 0; i < N; ++i) {
+    benchmark::DoNotOptimize(window->push(prices[tick++ % prices.size()]));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(window->push(prices[tick++ % prices.size()]));
+    const auto spans = std::as_const(*window).readable_spans();
+    double sum = 0;
+    double min = spans[0].front();
+    double max = min;
+    for (auto span : spans) {
+      sum = std::accumulate(span.begin(), span.end(), sum);
+      for (double p : span) {
+        min = std::min(min, p);
+        max = std::max(max, p);
+      }
+    }
+    const double mean = sum / static_cast<double>(N);
+    double m2 = 0;
+    for (auto span : spans) {
+      for (double p : span) {
+        m2 += (p - mean) * (p - mean);
+      }
+    }
+    Stats stats{sum, mean, std::sqrt(m2 / static_cast<double>(N)), min, max};
+    benchmark::DoNotOptimize(stats);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+template <size_t N>
+static void BM_Rolling_Recompute(benchmark::State& state) {
+  const auto prices = make_prices();
+  auto window = std::make_unique<loon::RollingWindow<double, N>>();
+  for (size_t i = 0; i < N + N / 3; ++i) {
+    window->push(prices[i % prices.size()]);
+  }
+
+  for (auto _ : state) {
+    window->recompute();
+    benchmark::DoNotOptimize(window->variance());
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(BM_Rolling_Incremental<64>)->Name("Rolling/Incremental/64");
+BENCHMARK(BM_Rolling_Incremental<1024>)->Name("Rolling/Incremental/1024");
+BENCHMARK(BM_Rolling_Incremental<16384>)->Name("Rolling/Incremental/16384");
+BENCHMARK(BM_Rolling_Incremental<65536>)->Name("Rolling/Incremental/65536");
+BENCHMARK(BM_Rolling_Naive<64>)->Name("Rolling/Naive/64");
+BENCHMARK(BM_Rolling_Naive<1024>)->Name("Rolling/Naive/1024");
+BENCHMARK(BM_Rolling_Naive<16384>)->Name("Rolling/Naive/16384");
+BENCHMARK(BM_Rolling_Naive<65536>)->Name("Rolling/Naive/65536");
+BENCHMARK(BM_Rolling_Recompute<64>)->Name("Rolling/Recompute/64");
+BENCHMARK(BM_Rolling_Recompute<65536>)->Name("Rolling/Recompute/65536");
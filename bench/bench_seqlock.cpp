@@ -0,0 +1,144 @@
+#include <loon/seqlock.hpp>
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Message types
+// ----------------------------------------------------------------------------
+
+struct TopOfBook {
+  int64_t bid;
+  int64_t ask;
+  int64_t bid_size;
+  int64_t ask_size;
+  int64_t timestamp;
+  int64_t sequence;
+}; // 48 bytes
+
+// ----------------------------------------------------------------------------
+// Uncontended: a single thread storing or loading
+// ----------------------------------------------------------------------------
+
+static void BM_Seqlock_Store(benchmark::State& state) {
+  loon::Seqlock<TopOfBook> slot;
+  TopOfBook quote{};
+  for (auto _ : state) {
+    ++quote.sequence;
+    slot.store(quote);
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Seqlock_Store);
+
+static void BM_Seqlock_Load(benchmark::State& state) {
+  loon::Seqlock<TopOfBook> slot;
+  slot.store(TopOfBook{});
+  for (auto _ : state) {
+    auto quote = slot.load();
+    benchmark::DoNotOptimize(quote);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Seqlock_Load);
+
+// ----------------------------------------------------------------------------
+// Contended: one writer storing as fast as it can while state.range(0) readers poll.
+// Writer throughput is items_per_second; reader latency is reported per load.
+// ----------------------------------------------------------------------------
+
+static void BM_Seqlock_Writer_Contended(benchmark::State& state) {
+  const auto readers = static_cast<int>(state.range(0));
+  loon::Seqlock<TopOfBook> slot;
+  std::atomic<bool> done{false};
+  std::atomic<int64_t> loads{0};
+
+  std::vector<std::thread> threads;
+  for (int r = 0; r < readers; ++r) {
+    threads.emplace_back([&] {
+      int64_t local = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        auto quote = slot.load();
+        benchmark::DoNotOptimize(quote);
+        ++local;
+      }
+      loads.fetch_add(local, std::memory_order_relaxed);
+    });
+  }
+
+  TopOfBook quote{};
+  for (auto _ : state) {
+    ++quote.sequence;
+    slot.store(quote);
+    benchmark::ClobberMemory();
+  }
+
+  done.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  state.SetItemsProcessed(state.iterations());
+  state.counters["reader_loads"] = benchmark::Counter(static_cast<double>(loads.load()));
+}
+BENCHMARK(BM_Seqlock_Writer_Contended)->DenseRange(0, 4)->UseRealTime();
+
+// Latency of one reader while the writer stores continuously and state.range(0) other
+// readers poll the same slot
+static void BM_Seqlock_Reader_Contended(benchmark::State& state) {
+  const auto readers = static_cast<int>(state.range(0));
+  loon::Seqlock<TopOfBook> slot;
+  std::atomic<bool> done{false};
+
+  std::vector<std::thread> threads;
+  threads.emplace_back([&] {
+    TopOfBook quote{};
+    while (!done.load(std::memory_order_relaxed)) {
+      ++quote.sequence;
+      slot.store(quote);
+    }
+  });
+  for (int r = 0; r < readers; ++r) {
+    threads.emplace_back([&] {
+      while (!done.load(std::memory_order_relaxed)) {
+        auto quote = slot.load();
+        benchmark::DoNotOptimize(quote);
+      }
+    });
+  }
+
+  for (auto _ : state) {
+    auto quote = slot.load();
+    benchmark::DoNotOptimize(quote);
+  }
+
+  done.store(true, std::memory_order_relaxed);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Seqlock_Reader_Contended)->DenseRange(0, 3)->UseRealTime();
+
+// Baseline: a consumer that only wants the newest quote still drains every stale one
+static void BM_SpscQueue_DrainToLatest(benchmark::State& state) {
+  const auto backlog = state.range(0);
+  loon::SpscQueue<TopOfBook, 1024> queue;
+  TopOfBook quote{};
+  for (auto _ : state) {
+    for (int64_t i = 0; i < backlog; ++i) {
+      ++quote.sequence;
+      benchmark::DoNotOptimize(queue.push(quote));
+    }
+    TopOfBook latest;
+    while (queue.pop(latest)) {
+    }
+    benchmark::DoNotOptimize(latest);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SpscQueue_DrainToLatest)->RangeMultiplier(4)->Range(1, 64);
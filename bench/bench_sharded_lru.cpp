@@ -0,0 +1,81 @@
+#include <loon/sharded_lru.hpp>
+#include <loon/wait.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "mutex_lru.hpp"
+#include "zipf.hpp"
+
+// Zipfian keys (s = 0.99) over 1M keys shared by every thread
+constexpr uint64_t KEY_SPACE = 1 << 20;
+constexpr uint32_t CAPACITY = 1 << 16;
+
+static const std::vector<uint64_t>& shared_keys() {
+  static const auto keys = zipf_keys(KEY_SPACE, 0.99, 1 << 20);
+  return keys;
+}
+
+// ----------------------------------------------------------------------------
+// Read-through workload: get, and put on a miss. state.range(0) threads share one
+// cache; each walks its own stretch of the Zipfian key sequence.
+// ----------------------------------------------------------------------------
+
+template <typename Cache>
+static void BM_Cache_ZipfGetOrPut(benchmark::State& state) {
+  const auto threads = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
+  const auto& keys = shared_keys();
+  Cache cache(CAPACITY);
+  for (size_t i = 0; i < keys.size(); ++i) {
+    cache.put(keys[i], keys[i]);
+  }
+
+  const size_t per_thread = count / threads;
+  size_t offset = 0;
+  for (auto _ : state) {
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+      const size_t start = offset + t * per_thread;
+      workers.emplace_back([&cache, &keys, start, per_thread] {
+        for (size_t i = 0; i < per_thread; ++i) {
+          const auto key = keys[(start + i) & (keys.size() - 1)];
+          auto value = cache.get(key);
+          if (!value) {
+            cache.put(key, key);
+          }
+          benchmark::DoNotOptimize(value);
+        }
+      });
+    }
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    offset += count;
+  }
+  state.SetItemsProcessed(state.iterations() * per_thread * threads);
+}
+
+template <typename Lock>
+struct Sharded : loon::ShardedLRU<uint64_t, uint64_t, Lock> {
+  explicit Sharded(uint32_t capacity) : loon::ShardedLRU<uint64_t, uint64_t, Lock>(capacity, 64) {}
+};
+
+BENCHMARK(BM_Cache_ZipfGetOrPut<MutexLRU<uint64_t, uint64_t>>)
+    ->Name("ShardedLRU/Zipf/GlobalMutex")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_Cache_ZipfGetOrPut<Sharded<std::mutex>>)
+    ->Name("ShardedLRU/Zipf/Mutex")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
+BENCHMARK(BM_Cache_ZipfGetOrPut<Sharded<loon::SpinLock<>>>)
+    ->Name("ShardedLRU/Zipf/SpinLock")
+    ->RangeMultiplier(2)
+    ->Range(1, 64)
+    ->UseRealTime();
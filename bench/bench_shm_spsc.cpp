@@ -0,0 +1,139 @@
+#include <loon/shm_spsc.hpp>
+#include <loon/spsc.hpp>
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <memory>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// ----------------------------------------------------------------------------
+// Shared peer loops, run on a thread (in-process) or in a forked child (cross-process)
+// ----------------------------------------------------------------------------
+
+using Queue = loon::SpscQueue<int64_t, 4096>;
+constexpr int64_t STOP = -1;
+
+// Pops a batch size, consumes that many items, then acknowledges; exits on STOP.
+static void drain_peer(Queue& data, Queue& ack) {
+  int64_t batch;
+  for (;;) {
+    while (!data.pop(batch)) {
+    }
+    if (batch == STOP)
+      return;
+    int64_t value;
+    for (int64_t i = 0; i < batch; ++i) {
+      while (!data.pop(value)) {
+      }
+      benchmark::DoNotOptimize(value);
+    }
+    while (!ack.push(batch)) {
+    }
+  }
+}
+
+// Echoes every value back; exits on STOP.
+static void echo_peer(Queue& ping, Queue& pong) {
+  int64_t value;
+  for (;;) {
+    while (!ping.pop(value)) {
+    }
+    if (value == STOP)
+      return;
+    while (!pong.push(value)) {
+    }
+  }
+}
+
+static void push_batch(benchmark::State& state, Queue& data, Queue& ack) {
+  const auto count = static_cast<int64_t>(state.range(0));
+  int64_t acked;
+  for (auto _ : state) {
+    while (!data.push(count)) {
+    }
+    for (int64_t i = 0; i < count; ++i) {
+      while (!data.push(i)) {
+      }
+    }
+    while (!ack.pop(acked)) {
+    }
+  }
+  while (!data.push(STOP)) {
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void ping_pong(benchmark::State& state, Queue& ping, Queue& pong) {
+  int64_t value = 0;
+  int64_t echoed;
+  for (auto _ : state) {
+    while (!ping.push(value++)) {
+    }
+    while (!pong.pop(echoed)) {
+    }
+    benchmark::DoNotOptimize(echoed);
+  }
+  while (!ping.push(STOP)) {
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Runs peer in a forked child over two shared memory queues while the parent runs driver.
+template <typename Peer, typename Driver>
+static void run_cross_process(benchmark::State& state, Peer peer, Driver driver) {
+  auto forward = loon::ShmSpscQueue<int64_t, 4096>::create_anonymous();
+  auto backward = loon::ShmSpscQueue<int64_t, 4096>::create_anonymous();
+
+  const pid_t child = ::fork();
+  if (child < 0) {
+    state.SkipWithError("fork failed");
+    return;
+  }
+  if (child == 0) {
+    peer(forward.queue(), backward.queue());
+    ::_exit(0);
+  }
+
+  driver(state, forward.queue(), backward.queue());
+  ::waitpid(child, nullptr, 0);
+}
+
+// Same topology with the peer on a thread and plain in-process queues.
+template <typename Peer, typename Driver>
+static void run_in_process(benchmark::State& state, Peer peer, Driver driver) {
+  auto forward = std::make_unique<Queue>();
+  auto backward = std::make_unique<Queue>();
+  std::thread thread([&] { peer(*forward, *backward); });
+  driver(state, *forward, *backward);
+  thread.join();
+}
+
+// ----------------------------------------------------------------------------
+// Throughput: producer streams batches, consumer acknowledges each batch
+// ----------------------------------------------------------------------------
+
+static void BM_SpscQueue_InProcess_Throughput(benchmark::State& state) {
+  run_in_process(state, drain_peer, push_batch);
+}
+BENCHMARK(BM_SpscQueue_InProcess_Throughput)->Range(1024, 1 << 16)->UseRealTime();
+
+static void BM_ShmSpscQueue_CrossProcess_Throughput(benchmark::State& state) {
+  run_cross_process(state, drain_peer, push_batch);
+}
+BENCHMARK(BM_ShmSpscQueue_CrossProcess_Throughput)->Range(1024, 1 << 16)->UseRealTime();
+
+// ----------------------------------------------------------------------------
+// Latency: one value ping-pongs between the two sides
+// ----------------------------------------------------------------------------
+
+static void BM_SpscQueue_InProcess_RoundTrip(benchmark::State& state) {
+  run_in_process(state, echo_peer, ping_pong);
+}
+BENCHMARK(BM_SpscQueue_InProcess_RoundTrip)->UseRealTime();
+
+static void BM_ShmSpscQueue_CrossProcess_RoundTrip(benchmark::State& state) {
+  run_cross_process(state, echo_peer, ping_pong);
+}
+BENCHMARK(BM_ShmSpscQueue_CrossProcess_RoundTrip)->UseRealTime();
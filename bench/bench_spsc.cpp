@@ -1,12 +1,15 @@
 #include <loon/spsc.hpp>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <benchmark/benchmark.h>
 #include <cstdint>
-#include <mutex>
-#include <queue>
+#include <span>
 #include <thread>
+#include <vector>
+
+#include "mutex_queue.hpp"
 
 // ----------------------------------------------------------------------------
 // Message types of different sizes
@@ -38,7 +41,7 @@ static void BM_SpscQueue_Push(benchmark::State& state) {
   for (auto _ : state) {
     loon::SpscQueue<int, 4096> queue;
     for (size_t i = 0; i < size; ++i) {
-      queue.push(static_cast<int>(i));
+      benchmark::DoNotOptimize(queue.push(static_cast<int>(i)));
     }
     benchmark::DoNotOptimize(queue);
   }
@@ -52,13 +55,13 @@ static void BM_SpscQueue_Pop(benchmark::State& state) {
     state.PauseTiming();
     loon::SpscQueue<int, 4096> queue;
     for (size_t i = 0; i < size; ++i) {
-      queue.push(static_cast<int>(i));
+      benchmark::DoNotOptimize(queue.push(static_cast<int>(i)));
     }
     state.ResumeTiming();
 
-    int val;
+    int val{};
     for (size_t i = 0; i < size; ++i) {
-      queue.pop(val);
+      benchmark::DoNotOptimize(queue.pop(val));
       benchmark::DoNotOptimize(val);
     }
   }
@@ -69,10 +72,10 @@ BENCHMARK(BM_SpscQueue_Pop)->Range(64, 4096);
 static void BM_SpscQueue_PushPop_Interleaved(benchmark::State& state) {
   loon::SpscQueue<int, 1024> queue;
   int value = 0;
-  int out;
+  int out{};
   for (auto _ : state) {
-    queue.push(value++);
-    queue.pop(out);
+    benchmark::DoNotOptimize(queue.push(value++));
+    benchmark::DoNotOptimize(queue.pop(out));
     benchmark::DoNotOptimize(out);
   }
   state.SetItemsProcessed(state.iterations() * 2);
@@ -90,8 +93,8 @@ static void BM_SpscQueue_RoundTrip(benchmark::State& state) {
   T out{};
 
   for (auto _ : state) {
-    queue.push(msg);
-    queue.pop(out);
+    benchmark::DoNotOptimize(queue.push(msg));
+    benchmark::DoNotOptimize(queue.pop(out));
     benchmark::DoNotOptimize(out);
   }
 
@@ -103,6 +106,30 @@ BENCHMARK(BM_SpscQueue_RoundTrip<Msg16B>)->Name("SpscQueue/RoundTrip/16B");
 BENCHMARK(BM_SpscQueue_RoundTrip<Msg64B>)->Name("SpscQueue/RoundTrip/64B");
 BENCHMARK(BM_SpscQueue_RoundTrip<Msg256B>)->Name("SpscQueue/RoundTrip/256B");
 
+template <typename T>
+static void BM_SpscQueue_RoundTrip_InPlace(benchmark::State& state) {
+  loon::SpscQueue<T, 1024> queue;
+  int64_t id = 0;
+
+  for (auto _ : state) {
+    if (auto slot = queue.try_reserve()) {
+      slot->get().id = id++;
+      queue.commit();
+    }
+    if (auto msg = queue.front()) {
+      benchmark::DoNotOptimize(msg->get().id);
+      queue.release();
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * 2);
+  state.SetBytesProcessed(state.iterations() * sizeof(T) * 2);
+}
+
+BENCHMARK(BM_SpscQueue_RoundTrip_InPlace<Msg16B>)->Name("SpscQueue/RoundTrip/InPlace/16B");
+BENCHMARK(BM_SpscQueue_RoundTrip_InPlace<Msg64B>)->Name("SpscQueue/RoundTrip/InPlace/64B");
+BENCHMARK(BM_SpscQueue_RoundTrip_InPlace<Msg256B>)->Name("SpscQueue/RoundTrip/InPlace/256B");
+
 template <typename T>
 static void BM_SpscQueue_Throughput(benchmark::State& state) {
   loon::SpscQueue<T, 4096> queue;
@@ -112,10 +139,10 @@ static void BM_SpscQueue_Throughput(benchmark::State& state) {
 
   for (auto _ : state) {
     for (size_t i = 0; i < batch; ++i) {
-      queue.push(msg);
+      benchmark::DoNotOptimize(queue.push(msg));
     }
     for (size_t i = 0; i < batch; ++i) {
-      queue.pop(out);
+      benchmark::DoNotOptimize(queue.pop(out));
       benchmark::DoNotOptimize(out);
     }
   }
@@ -128,6 +155,158 @@ BENCHMARK(BM_SpscQueue_Throughput<Msg16B>)->Name("SpscQueue/Throughput/16B");
 BENCHMARK(BM_SpscQueue_Throughput<Msg64B>)->Name("SpscQueue/Throughput/64B");
 BENCHMARK(BM_SpscQueue_Throughput<Msg256B>)->Name("SpscQueue/Throughput/256B");
 
+// ----------------------------------------------------------------------------
+// Batch benchmarks - push_n/pop_n vs per-element loop
+// ----------------------------------------------------------------------------
+
+// Moves 4096 messages per iteration in chunks of state.range(0), one element at a time
+template <typename T>
+static void BM_SpscQueue_Loop(benchmark::State& state) {
+  const auto batch = static_cast<size_t>(state.range(0));
+  constexpr size_t total = 4096;
+  loon::SpscQueue<T, 1024> queue;
+  T msg{};
+  T out{};
+
+  for (auto _ : state) {
+    for (size_t done = 0; done < total; done += batch) {
+      for (size_t i = 0; i < batch; ++i) {
+        benchmark::DoNotOptimize(queue.push(msg));
+      }
+      for (size_t i = 0; i < batch; ++i) {
+        benchmark::DoNotOptimize(queue.pop(out));
+        benchmark::DoNotOptimize(out);
+      }
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * total * 2);
+  state.SetBytesProcessed(state.iterations() * total * sizeof(T) * 2);
+}
+
+// Moves 4096 messages per iteration in chunks of state.range(0) with push_n/pop_n
+template <typename T>
+static void BM_SpscQueue_Batch(benchmark::State& state) {
+  const auto batch = static_cast<size_t>(state.range(0));
+  constexpr size_t total = 4096;
+  loon::SpscQueue<T, 1024> queue;
+  std::vector<T> in(batch);
+  std::vector<T> out(batch);
+
+  for (auto _ : state) {
+    for (size_t done = 0; done < total; done += batch) {
+      benchmark::DoNotOptimize(queue.push_n(in));
+      benchmark::DoNotOptimize(queue.pop_n(std::span<T>(out)));
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * total * 2);
+  state.SetBytesProcessed(state.iterations() * total * sizeof(T) * 2);
+}
+
+BENCHMARK(BM_SpscQueue_Loop<Msg16B>)->Name("SpscQueue/Loop/16B")->RangeMultiplier(8)->Range(1, 512);
+BENCHMARK(BM_SpscQueue_Batch<Msg16B>)
+    ->Name("SpscQueue/Batch/16B")
+    ->RangeMultiplier(8)
+    ->Range(1, 512);
+BENCHMARK(BM_SpscQueue_Loop<Msg256B>)
+    ->Name("SpscQueue/Loop/256B")
+    ->RangeMultiplier(8)
+    ->Range(1, 512);
+BENCHMARK(BM_SpscQueue_Batch<Msg256B>)
+    ->Name("SpscQueue/Batch/256B")
+    ->RangeMultiplier(8)
+    ->Range(1, 512);
+
+// ----------------------------------------------------------------------------
+// Capacity benchmarks - modulo vs mask indexing, heap vs huge-page storage
+// ----------------------------------------------------------------------------
+
+// Raw index arithmetic with a capacity only known at runtime: divide vs mask
+static void BM_Index_Modulo(benchmark::State& state) {
+  size_t capacity = 1000;
+  benchmark::DoNotOptimize(capacity);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(i++ % capacity);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Index_Modulo);
+
+static void BM_Index_Mask(benchmark::State& state) {
+  size_t mask = 1023;
+  benchmark::DoNotOptimize(mask);
+  size_t i = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(i++ & mask);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Index_Mask);
+
+template <typename Queue>
+static void stream_through(benchmark::State& state, Queue& queue) {
+  constexpr size_t batch = 1000;
+  int out{};
+  for (auto _ : state) {
+    for (size_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.push(static_cast<int>(i)));
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.pop(out));
+      benchmark::DoNotOptimize(out);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch * 2);
+}
+
+static void BM_SpscQueue_Capacity_Modulo(benchmark::State& state) {
+  loon::SpscQueue<int, 1000> queue; // non power of two: modulo
+  stream_through(state, queue);
+}
+BENCHMARK(BM_SpscQueue_Capacity_Modulo);
+
+static void BM_SpscQueue_Capacity_Mask(benchmark::State& state) {
+  loon::SpscQueue<int, 1024> queue; // power of two: mask
+  stream_through(state, queue);
+}
+BENCHMARK(BM_SpscQueue_Capacity_Mask);
+
+static void BM_SpscQueue_Capacity_Dynamic(benchmark::State& state) {
+  loon::SpscQueue<int, loon::DYNAMIC_CAPACITY> queue(1000); // rounded to 1024: mask
+  stream_through(state, queue);
+}
+BENCHMARK(BM_SpscQueue_Capacity_Dynamic);
+
+// Streams 64B messages through a 64 MiB queue so every slot touch is a new page
+static void BM_SpscQueue_Dynamic_Pages(benchmark::State& state) {
+  const auto pages = static_cast<loon::PageMode>(state.range(0));
+  constexpr size_t capacity = 1 << 20;
+  loon::SpscQueue<Msg64B, loon::DYNAMIC_CAPACITY> queue(capacity, pages);
+  Msg64B msg{};
+  Msg64B out{};
+  constexpr size_t batch = 1 << 16;
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.push(msg));
+    }
+    for (size_t i = 0; i < batch; ++i) {
+      benchmark::DoNotOptimize(queue.pop(out));
+      benchmark::DoNotOptimize(out);
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * batch * 2);
+  state.SetBytesProcessed(state.iterations() * batch * sizeof(Msg64B) * 2);
+}
+BENCHMARK(BM_SpscQueue_Dynamic_Pages)
+    ->Arg(static_cast<int>(loon::PageMode::Normal))
+    ->Arg(static_cast<int>(loon::PageMode::Transparent))
+    ->Arg(static_cast<int>(loon::PageMode::Huge));
+
 // ----------------------------------------------------------------------------
 // Multi-threaded benchmark (real SPSC use case)
 // ----------------------------------------------------------------------------
@@ -167,45 +346,139 @@ static void BM_SpscQueue_ProducerConsumer(benchmark::State& state) {
 }
 BENCHMARK(BM_SpscQueue_ProducerConsumer)->Range(1024, 1 << 16);
 
-// ----------------------------------------------------------------------------
-// Mutex-based queue comparison (baseline)
-// ----------------------------------------------------------------------------
+// Same workload as BM_SpscQueue_ProducerConsumer with 65536 items, moved in batches of
+// state.range(0) through push_n/pop_n so each batch publishes its index once.
+static void BM_SpscQueue_ProducerConsumer_Batch(benchmark::State& state) {
+  const auto batch = static_cast<size_t>(state.range(0));
+  constexpr size_t count = 1 << 16;
 
-template <typename T>
-class MutexQueue {
- public:
-  explicit MutexQueue(size_t /*capacity*/) {}
-
-  bool push(const T& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    queue_.push(value);
-    return true;
+  for (auto _ : state) {
+    loon::SpscQueue<int, 4096> queue;
+
+    // Consumer thread
+    std::thread consumer([&] {
+      std::vector<int> out(batch);
+      size_t local_consumed = 0;
+      while (local_consumed < count) {
+        const auto popped = queue.pop_n(std::span<int>(out));
+        benchmark::DoNotOptimize(out.data());
+        local_consumed += popped;
+      }
+    });
+
+    // Producer (main thread)
+    std::vector<int> in(batch);
+    for (size_t produced = 0; produced < count;) {
+      const auto chunk = std::min(batch, count - produced);
+      for (size_t i = 0; i < chunk; ++i) {
+        in[i] = static_cast<int>(produced + i);
+      }
+      size_t pushed = 0;
+      while (pushed < chunk) {
+        pushed += queue.push_n(std::span<const int>(in.data() + pushed, chunk - pushed));
+      }
+      produced += chunk;
+    }
+
+    consumer.join();
   }
 
-  bool pop(T& value) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (queue_.empty()) {
-      return false;
+  state.SetItemsProcessed(state.iterations() * count * 2);
+}
+BENCHMARK(BM_SpscQueue_ProducerConsumer_Batch)->RangeMultiplier(8)->Range(1, 512);
+
+// Producer builds each message and consumer reads it back; push/pop copy the message into
+// and out of the ring.
+template <typename T>
+static void BM_SpscQueue_ProducerConsumer_Copy(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    loon::SpscQueue<T, 1024> queue;
+
+    // Consumer thread
+    std::thread consumer([&] {
+      T msg{};
+      size_t local_consumed = 0;
+      while (local_consumed < count) {
+        if (queue.pop(msg)) {
+          benchmark::DoNotOptimize(msg.id);
+          ++local_consumed;
+        }
+      }
+    });
+
+    // Producer (main thread)
+    T msg{};
+    for (size_t i = 0; i < count; ++i) {
+      msg.id = static_cast<int64_t>(i);
+      msg.timestamp = static_cast<int64_t>(i);
+      while (!queue.push(msg)) {
+        // Spin until space available
+      }
     }
-    value = queue_.front();
-    queue_.pop();
-    return true;
+
+    consumer.join();
   }
 
-  bool empty() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return queue_.empty();
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+// Same workload, but messages are built and read in place with try_reserve/commit and
+// front/release, so the payload is never copied.
+template <typename T>
+static void BM_SpscQueue_ProducerConsumer_InPlace(benchmark::State& state) {
+  const auto count = static_cast<size_t>(state.range(0));
+
+  for (auto _ : state) {
+    loon::SpscQueue<T, 1024> queue;
+
+    // Consumer thread
+    std::thread consumer([&] {
+      size_t local_consumed = 0;
+      while (local_consumed < count) {
+        if (auto msg = queue.front()) {
+          benchmark::DoNotOptimize(msg->get().id);
+          queue.release();
+          ++local_consumed;
+        }
+      }
+    });
+
+    // Producer (main thread)
+    for (size_t i = 0; i < count; ++i) {
+      auto slot = queue.try_reserve();
+      while (!slot) {
+        slot = queue.try_reserve(); // Spin until space available
+      }
+      slot->get().id = static_cast<int64_t>(i);
+      slot->get().timestamp = static_cast<int64_t>(i);
+      queue.commit();
+    }
+
+    consumer.join();
   }
 
- private:
-  mutable std::mutex mutex_;
-  std::queue<T> queue_;
-};
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+  state.SetBytesProcessed(state.iterations() * state.range(0) * sizeof(T) * 2);
+}
+
+BENCHMARK(BM_SpscQueue_ProducerConsumer_Copy<Msg256B>)
+    ->Name("SpscQueue/ProducerConsumer/Copy/256B")
+    ->Range(1024, 1 << 16);
+BENCHMARK(BM_SpscQueue_ProducerConsumer_InPlace<Msg256B>)
+    ->Name("SpscQueue/ProducerConsumer/InPlace/256B")
+    ->Range(1024, 1 << 16);
+
+// ----------------------------------------------------------------------------
+// Mutex-based queue comparison (baseline)
+// ----------------------------------------------------------------------------
 
 static void BM_MutexQueue_PushPop_Interleaved(benchmark::State& state) {
   MutexQueue<int> queue(1024);
   int value = 0;
-  int out;
+  int out{};
   for (auto _ : state) {
     queue.push(value++);
     queue.pop(out);
@@ -0,0 +1,176 @@
+#include <loon/spsc.hpp>
+#include <loon/spsc_bytes.hpp>
+
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <span>
+#include <thread>
+#include <vector>
+
+// ----------------------------------------------------------------------------
+// Mixed-size message distribution
+// ----------------------------------------------------------------------------
+
+struct Msg256B {
+  int64_t id;
+  int64_t timestamp;
+  std::array<char, 240> payload;
+}; // 256 bytes
+
+// 70% 24B, 20% 64B, 10% 256B: most messages are small, a few need the full 256B
+static std::vector<size_t> make_sizes(size_t count) {
+  std::mt19937 rng(42);
+  std::discrete_distribution<int> pick({70, 20, 10});
+  constexpr std::array<size_t, 3> sizes{24, 64, 256};
+  std::vector<size_t> result(count);
+  for (auto& size : result) {
+    size = sizes[pick(rng)];
+  }
+  return result;
+}
+
+static const std::vector<size_t>& mixed_sizes() {
+  static const auto sizes = make_sizes(4096);
+  return sizes;
+}
+
+static size_t total_bytes(const std::vector<size_t>& sizes) {
+  size_t total = 0;
+  for (auto size : sizes) {
+    total += size;
+  }
+  return total;
+}
+
+// ----------------------------------------------------------------------------
+// Single-threaded benchmarks
+// ----------------------------------------------------------------------------
+
+static void BM_SpscBytes_Mixed_Throughput(benchmark::State& state) {
+  const auto& sizes = mixed_sizes();
+  loon::SpscBytes<1 << 16> ring;
+  std::array<std::byte, 256> msg{};
+  constexpr size_t batch = 64;
+
+  for (auto _ : state) {
+    for (size_t done = 0; done < sizes.size(); done += batch) {
+      for (size_t i = done; i < done + batch; ++i) {
+        benchmark::DoNotOptimize(ring.push(std::span<const std::byte>(msg.data(), sizes[i])));
+      }
+      for (size_t i = 0; i < batch; ++i) {
+        auto record = ring.front();
+        benchmark::DoNotOptimize(record);
+        ring.release();
+      }
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * sizes.size() * 2);
+  state.SetBytesProcessed(state.iterations() * total_bytes(sizes) * 2);
+}
+BENCHMARK(BM_SpscBytes_Mixed_Throughput);
+
+// Same message stream, every message padded to Msg256B
+static void BM_SpscQueue_Padded_Throughput(benchmark::State& state) {
+  const auto& sizes = mixed_sizes();
+  loon::SpscQueue<Msg256B, 256> queue;
+  Msg256B msg{};
+  Msg256B out{};
+  constexpr size_t batch = 64;
+
+  for (auto _ : state) {
+    for (size_t done = 0; done < sizes.size(); done += batch) {
+      for (size_t i = 0; i < batch; ++i) {
+        benchmark::DoNotOptimize(queue.push(msg));
+      }
+      for (size_t i = 0; i < batch; ++i) {
+        benchmark::DoNotOptimize(queue.pop(out));
+      }
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * sizes.size() * 2);
+  state.SetBytesProcessed(state.iterations() * total_bytes(sizes) * 2);
+}
+BENCHMARK(BM_SpscQueue_Padded_Throughput);
+
+// ----------------------------------------------------------------------------
+// Multi-threaded benchmarks
+// ----------------------------------------------------------------------------
+
+static void BM_SpscBytes_Mixed_ProducerConsumer(benchmark::State& state) {
+  const auto& sizes = mixed_sizes();
+
+  for (auto _ : state) {
+    loon::SpscBytes<1 << 16> ring;
+
+    // Consumer thread
+    std::thread consumer([&] {
+      size_t local_consumed = 0;
+      while (local_consumed < sizes.size()) {
+        if (auto record = ring.front()) {
+          benchmark::DoNotOptimize(record->data());
+          ring.release();
+          ++local_consumed;
+        }
+      }
+    });
+
+    // Producer (main thread), builds each message in place
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      auto region = ring.try_reserve(sizes[i]);
+      while (!region) {
+        region = ring.try_reserve(sizes[i]); // Spin until space available
+      }
+      std::memset(region->data(), static_cast<int>(i), region->size());
+      ring.commit(sizes[i]);
+    }
+
+    consumer.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * sizes.size() * 2);
+  state.SetBytesProcessed(state.iterations() * total_bytes(mixed_sizes()) * 2);
+}
+BENCHMARK(BM_SpscBytes_Mixed_ProducerConsumer);
+
+// Same ring footprint (64 KiB), every message padded to Msg256B
+static void BM_SpscQueue_Padded_ProducerConsumer(benchmark::State& state) {
+  const auto& sizes = mixed_sizes();
+
+  for (auto _ : state) {
+    loon::SpscQueue<Msg256B, 256> queue;
+
+    // Consumer thread
+    std::thread consumer([&] {
+      size_t local_consumed = 0;
+      while (local_consumed < sizes.size()) {
+        if (auto msg = queue.front()) {
+          benchmark::DoNotOptimize(msg->get().id);
+          queue.release();
+          ++local_consumed;
+        }
+      }
+    });
+
+    // Producer (main thread), builds each message in place
+    for (size_t i = 0; i < sizes.size(); ++i) {
+      auto slot = queue.try_reserve();
+      while (!slot) {
+        slot = queue.try_reserve(); // Spin until space available
+      }
+      std::memset(&slot->get(), static_cast<int>(i), sizes[i]);
+      queue.commit();
+    }
+
+    consumer.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * sizes.size() * 2);
+  state.SetBytesProcessed(state.iterations() * total_bytes(mixed_sizes()) * 2);
+}
+BENCHMARK(BM_SpscQueue_Padded_ProducerConsumer);
@@ -0,0 +1,107 @@
+#include <loon/time_window.hpp>
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+
+// ----------------------------------------------------------------------------
+// A time window keeps the events of the last HORIZON. Time is simulated, so every run
+// sees the same arrivals:
+//   Steady - one event per microsecond; each push expires about one old event
+//   Bursty - BURST events arrive at once every GAP, then nothing; each burst finds the
+//            whole previous burst expired, and holds more events than the initial capacity
+// TimeWindow is compared against a std::deque of (stamp, value) pairs expired one element
+// at a time from the front, the usual hand-rolled version.
+// ----------------------------------------------------------------------------
+
+using namespace std::chrono_literals;
+
+struct SimClock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<SimClock>;
+  static constexpr bool is_steady = true;
+  static time_point now() { return {}; }
+};
+
+using Stamp = SimClock::time_point;
+
+constexpr auto HORIZON = 1ms;
+constexpr size_t CAPACITY = 1024;
+constexpr int64_t BURST = 4096;
+constexpr auto GAP = 2ms;
+
+template <loon::WindowOverflow Overflow>
+static void BM_TimeWindow_Steady(benchmark::State& state) {
+  loon::TimeWindow<uint64_t, CAPACITY, SimClock> window(HORIZON, Overflow);
+  Stamp now{};
+  uint64_t value = 0;
+
+  for (auto _ : state) {
+    now += 1us;
+    window.push_at(now, value++);
+  }
+  benchmark::DoNotOptimize(window.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TimeWindow_Steady<loon::WindowOverflow::Evict>)->Name("TimeWindow/Steady/Evict");
+BENCHMARK(BM_TimeWindow_Steady<loon::WindowOverflow::Grow>)->Name("TimeWindow/Steady/Grow");
+
+static void BM_Deque_Steady(benchmark::State& state) {
+  std::deque<std::pair<Stamp, uint64_t>> window;
+  Stamp now{};
+  uint64_t value = 0;
+
+  for (auto _ : state) {
+    now += 1us;
+    while (!window.empty() && window.front().first <= now - HORIZON) {
+      window.pop_front();
+    }
+    window.emplace_back(now, value++);
+  }
+  benchmark::DoNotOptimize(window.size());
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Deque_Steady)->Name("Deque/Steady");
+
+template <loon::WindowOverflow Overflow>
+static void BM_TimeWindow_Bursty(benchmark::State& state) {
+  loon::TimeWindow<uint64_t, CAPACITY, SimClock> window(HORIZON, Overflow);
+  Stamp now{};
+  uint64_t value = 0;
+
+  for (auto _ : state) {
+    now += GAP;
+    for (int64_t i = 0; i < BURST; ++i) {
+      window.push_at(now, value++);
+    }
+    benchmark::DoNotOptimize(window.count(now));
+  }
+  state.counters["dropped"] = static_cast<double>(window.dropped());
+  state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_TimeWindow_Bursty<loon::WindowOverflow::Evict>)->Name("TimeWindow/Bursty/Evict");
+BENCHMARK(BM_TimeWindow_Bursty<loon::WindowOverflow::Grow>)->Name("TimeWindow/Bursty/Grow");
+
+static void BM_Deque_Bursty(benchmark::State& state) {
+  std::deque<std::pair<Stamp, uint64_t>> window;
+  Stamp now{};
+  uint64_t value = 0;
+
+  for (auto _ : state) {
+    now += GAP;
+    for (int64_t i = 0; i < BURST; ++i) {
+      while (!window.empty() && window.front().first <= now - HORIZON) {
+        window.pop_front();
+      }
+      window.emplace_back(now, value++);
+    }
+    benchmark::DoNotOptimize(window.size());
+  }
+  state.SetItemsProcessed(state.iterations() * BURST);
+}
+BENCHMARK(BM_Deque_Bursty)->Name("Deque/Bursty");
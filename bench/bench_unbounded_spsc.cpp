@@ -0,0 +1,137 @@
+#include <loon/spsc.hpp>
+#include <loon/unbounded_spsc.hpp>
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+// Steady state: the consumer keeps up, so both queues stay within one ring
+// ----------------------------------------------------------------------------
+
+static void BM_UnboundedSpsc_PushPop_Interleaved(benchmark::State& state) {
+  loon::UnboundedSpscQueue<int64_t> queue;
+  int64_t value = 0;
+  for (auto _ : state) {
+    queue.push(value);
+    benchmark::DoNotOptimize(queue.pop(value));
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_UnboundedSpsc_PushPop_Interleaved);
+
+static void BM_SpscQueue_PushPop_Interleaved_Bounded(benchmark::State& state) {
+  loon::SpscQueue<int64_t, 1024> queue;
+  int64_t value = 0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(queue.push(value));
+    benchmark::DoNotOptimize(queue.pop(value));
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_SpscQueue_PushPop_Interleaved_Bounded);
+
+// ----------------------------------------------------------------------------
+// Single-threaded bursts of state.range(0) items, pushed all at once and then drained.
+// Bursts beyond one segment chain new segments; later bursts reuse recycled ones.
+// ----------------------------------------------------------------------------
+
+static void BM_UnboundedSpsc_Burst(benchmark::State& state) {
+  const auto burst = state.range(0);
+  loon::UnboundedSpscQueue<int64_t> queue;
+  int64_t value = 0;
+  for (auto _ : state) {
+    for (int64_t i = 0; i < burst; ++i) {
+      queue.push(i);
+    }
+    for (int64_t i = 0; i < burst; ++i) {
+      benchmark::DoNotOptimize(queue.pop(value));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * burst * 2);
+}
+BENCHMARK(BM_UnboundedSpsc_Burst)->RangeMultiplier(8)->Range(64, 1 << 15);
+
+// ----------------------------------------------------------------------------
+// Bursty producer, stalling consumer: the producer emits bursts of state.range(0) items
+// every 20 us while the consumer stalls 200 us after every 8192 items, like a recorder
+// waiting on disk. The bounded queue reports how many items it had to drop.
+// ----------------------------------------------------------------------------
+
+constexpr int64_t BURSTS = 64;
+
+template <typename Push>
+static void produce_bursts(int64_t burst, Push&& push) {
+  for (int64_t b = 0; b < BURSTS; ++b) {
+    for (int64_t i = 0; i < burst; ++i) {
+      push(b * burst + i);
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(20));
+  }
+}
+
+static void stall_every(int64_t consumed) {
+  if (consumed % 8192 == 0)
+    std::this_thread::sleep_for(std::chrono::microseconds(200));
+}
+
+static void BM_UnboundedSpsc_Bursty(benchmark::State& state) {
+  const auto burst = state.range(0);
+  loon::UnboundedSpscQueue<int64_t> queue;
+
+  for (auto _ : state) {
+    std::thread consumer([&] {
+      int64_t value;
+      for (int64_t consumed = 1; consumed <= BURSTS * burst; ++consumed) {
+        while (!queue.pop(value)) {
+          std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(value);
+        stall_every(consumed);
+      }
+    });
+    produce_bursts(burst, [&](int64_t value) { queue.push(value); });
+    consumer.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * BURSTS * burst);
+  state.counters["dropped"] = 0;
+}
+BENCHMARK(BM_UnboundedSpsc_Bursty)->RangeMultiplier(4)->Range(256, 4096)->UseRealTime();
+
+static void BM_SpscQueue_Bursty_Bounded(benchmark::State& state) {
+  const auto burst = state.range(0);
+  loon::SpscQueue<int64_t, 1024> queue;
+  int64_t dropped = 0;
+
+  for (auto _ : state) {
+    std::atomic<bool> done{false};
+    std::thread consumer([&] {
+      int64_t value;
+      int64_t consumed = 0;
+      for (;;) {
+        if (queue.pop(value)) {
+          benchmark::DoNotOptimize(value);
+          stall_every(++consumed);
+        } else if (done.load(std::memory_order_acquire)) {
+          break;
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+    produce_bursts(burst, [&](int64_t value) {
+      if (!queue.push(value))
+        ++dropped;
+    });
+    done.store(true, std::memory_order_release);
+    consumer.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * BURSTS * burst);
+  state.counters["dropped"] =
+      benchmark::Counter(static_cast<double>(dropped), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SpscQueue_Bursty_Bounded)->RangeMultiplier(4)->Range(256, 4096)->UseRealTime();
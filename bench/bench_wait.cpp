@@ -0,0 +1,111 @@
+#include <loon/spsc.hpp>
+#include <loon/wait.hpp>
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <thread>
+
+// ----------------------------------------------------------------------------
+// Helpers
+// ----------------------------------------------------------------------------
+
+static int64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t thread_cpu_ns() {
+  timespec ts{};
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1'000'000'000LL + ts.tv_nsec;
+}
+
+constexpr int64_t STOP = -1;
+
+// ----------------------------------------------------------------------------
+// Low traffic: one message every 50 us. Reports the consumer's CPU usage while idle
+// and the latency from push to the consumer waking up with the message.
+// ----------------------------------------------------------------------------
+
+template <typename Wait>
+static void BM_Wait_LowTraffic(benchmark::State& state) {
+  loon::BlockingQueue<loon::SpscQueue<int64_t, 1024>, Wait> queue;
+  int64_t latency_sum = 0;
+  int64_t received = 0;
+  int64_t consumer_cpu = 0;
+
+  std::thread consumer([&] {
+    const auto cpu_start = thread_cpu_ns();
+    int64_t sent_at;
+    for (;;) {
+      queue.pop_wait(sent_at);
+      if (sent_at == STOP)
+        break;
+      latency_sum += now_ns() - sent_at;
+      ++received;
+    }
+    consumer_cpu = thread_cpu_ns() - cpu_start;
+  });
+
+  const auto wall_start = now_ns();
+  for (auto _ : state) {
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+    queue.push_wait(now_ns());
+  }
+  queue.push_wait(STOP);
+  consumer.join();
+  const auto wall = now_ns() - wall_start;
+
+  state.counters["consumer_cpu_pct"] = 100.0 * static_cast<double>(consumer_cpu) / wall;
+  state.counters["wake_latency_ns"] =
+      received == 0 ? 0.0 : static_cast<double>(latency_sum) / static_cast<double>(received);
+}
+
+BENCHMARK(BM_Wait_LowTraffic<loon::SpinWait>)
+    ->Name("Wait/LowTraffic/Spin")
+    ->Iterations(2000)
+    ->UseRealTime();
+BENCHMARK(BM_Wait_LowTraffic<loon::YieldWait<>>)
+    ->Name("Wait/LowTraffic/Yield")
+    ->Iterations(2000)
+    ->UseRealTime();
+BENCHMARK(BM_Wait_LowTraffic<loon::ParkWait<>>)
+    ->Name("Wait/LowTraffic/Park")
+    ->Iterations(2000)
+    ->UseRealTime();
+
+// ----------------------------------------------------------------------------
+// Saturated: producer and consumer run flat out, showing the cost of notify() on the
+// fast path (ParkWait pays a fence per operation).
+// ----------------------------------------------------------------------------
+
+template <typename Wait>
+static void BM_Wait_Saturated(benchmark::State& state) {
+  const auto count = static_cast<int64_t>(state.range(0));
+
+  for (auto _ : state) {
+    loon::BlockingQueue<loon::SpscQueue<int64_t, 4096>, Wait> queue;
+
+    std::thread consumer([&] {
+      int64_t value;
+      for (int64_t i = 0; i < count; ++i) {
+        queue.pop_wait(value);
+        benchmark::DoNotOptimize(value);
+      }
+    });
+
+    for (int64_t i = 0; i < count; ++i) {
+      queue.push_wait(i);
+    }
+    consumer.join();
+  }
+
+  state.SetItemsProcessed(state.iterations() * state.range(0) * 2);
+}
+
+BENCHMARK(BM_Wait_Saturated<loon::SpinWait>)->Name("Wait/Saturated/Spin")->Arg(1 << 16);
+BENCHMARK(BM_Wait_Saturated<loon::YieldWait<>>)->Name("Wait/Saturated/Yield")->Arg(1 << 16);
+BENCHMARK(BM_Wait_Saturated<loon::ParkWait<>>)->Name("Wait/Saturated/Park")->Arg(1 << 16);
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <loon/lru.hpp>
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+// One loon::LRU behind one mutex: the locking baseline in the concurrent cache benchmarks.
+template <typename K, typename V>
+class MutexLRU {
+ public:
+  explicit MutexLRU(uint32_t capacity) : cache_(capacity) {}
+
+  std::optional<V> get(const K& key) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (auto value = cache_.get(key))
+      return value->get();
+    return std::nullopt;
+  }
+
+  void put(const K& key, const V& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cache_.put(key, value);
+  }
+
+ private:
+  std::mutex mutex_;
+  loon::LRU<K, V> cache_;
+};
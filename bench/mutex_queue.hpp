@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <queue>
+
+// Mutex-protected std::queue used as the locking baseline in the queue benchmarks.
+template <typename T>
+class MutexQueue {
+ public:
+  explicit MutexQueue(size_t /*capacity*/) {}
+
+  bool push(const T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push(value);
+    return true;
+  }
+
+  bool pop(T& value) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (queue_.empty()) {
+      return false;
+    }
+    value = queue_.front();
+    queue_.pop();
+    return true;
+  }
+
+  bool empty() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.empty();
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::queue<T> queue_;
+};
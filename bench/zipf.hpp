@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+// Zipfian keys for the cache benchmarks: rank r is drawn with probability proportional to
+// 1 / r^s, so a few hot keys take most of the traffic. s = 0.99 is the YCSB default.
+inline std::vector<uint64_t> zipf_keys(uint64_t key_space, double s, size_t count) {
+  std::vector<double> cdf(key_space);
+  double sum = 0;
+  for (uint64_t r = 0; r < key_space; ++r) {
+    sum += 1.0 / std::pow(static_cast<double>(r + 1), s);
+    cdf[r] = sum;
+  }
+
+  std::mt19937_64 rng(42);
+  std::uniform_real_distribution<double> dist(0, sum);
+  std::vector<uint64_t> keys(count);
+  for (auto& key : keys) {
+    const auto rank = std::lower_bound(cdf.begin(), cdf.end(), dist(rng)) - cdf.begin();
+    key = static_cast<uint64_t>(rank);
+  }
+  return keys;
+}
@@ -0,0 +1,148 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file async_spsc.hpp
+/// @brief Coroutine awaitable wrapper around SpscQueue.
+
+#include <loon/spsc.hpp>
+#include <loon/wait.hpp>
+
+#include <atomic>
+#include <coroutine>
+#include <utility>
+
+namespace loon {
+
+/// @brief Executor that resumes a coroutine directly on the calling thread.
+struct InlineExecutor {
+  void operator()(std::coroutine_handle<> handle) const { handle.resume(); }
+};
+
+/// @brief A SpscQueue whose consumer can `co_await pop_async()` instead of polling.
+///
+/// When the queue holds a value, pop_async() completes without suspending and costs the
+/// same as pop(). When it is empty, the consumer coroutine parks its handle in the queue
+/// and suspends; the next successful push() hands the handle to the executor, which
+/// decides where the coroutine resumes (inline on the producer thread by default, or a
+/// caller-supplied event loop).
+///
+/// push() checks for a parked consumer with one relaxed load. On Linux the store/load
+/// handshake with a suspending consumer is made safe by membarrier(), which the consumer
+/// issues on its way to sleep, so push() needs no hardware fence; elsewhere both sides
+/// use a seq_cst fence, like ParkWait. The wake path only runs when a coroutine is
+/// actually suspended.
+/// At most one pop_async() may be pending, and a suspended coroutine must not be
+/// destroyed before it is resumed.
+///
+/// @tparam T The element type to store.
+/// @tparam N The maximum number of elements the queue can hold (must be > 0).
+/// @tparam Executor Callable with a std::coroutine_handle<> that resumes it.
+/// @par Example
+/// @code
+/// loon::AsyncSpscQueue<Request, 1024> requests;
+///
+/// Task serve() {
+///     for (;;) {
+///         Request request = co_await requests.pop_async();  // suspends while empty
+///         handle(request);
+///     }
+/// }
+///
+/// requests.push(request);  // producer thread, resumes serve() if it is waiting
+/// @endcode
+template <typename T, size_t N, typename Executor = InlineExecutor>
+class AsyncSpscQueue {
+ public:
+  using value_type = T;
+
+  /// @brief Awaitable returned by pop_async().
+  class PopAwaiter {
+   public:
+    /// @brief Pops without suspending when a value is already available.
+    bool await_ready() { return popped_ = queue_->queue_.pop(value_); }
+
+    /// @brief Parks the coroutine, unless a value arrived while parking.
+    /// @return false to resume immediately, true to stay suspended until push().
+    bool await_suspend(std::coroutine_handle<> handle) {
+      // Once the handle is published push() may resume us on another thread, which ends
+      // this awaiter's lifetime, so only the queue is touched from here on.
+      AsyncSpscQueue* queue = queue_;
+      // Release so the producer that takes the handle also sees the coroutine frame
+      queue->waiter_.store(handle.address(), std::memory_order_release);
+      // Pairs with the fence in push(): either we see the value, or push() sees the handle
+      detail::heavy_fence(queue->asymmetric_);
+      if (queue->queue_.empty())
+        return true;
+      // A value arrived while parking. Whoever takes the handle back resumes us; the pop
+      // itself is left to await_resume() so the queue never has two consumers.
+      return queue->waiter_.exchange(nullptr, std::memory_order_acq_rel) == nullptr;
+    }
+
+    /// @brief Returns the popped value.
+    T await_resume() {
+      if (!popped_)
+        popped_ = queue_->queue_.pop(value_); // Resumed after a push(), so a value is there
+      return std::move(value_);
+    }
+
+   private:
+    friend class AsyncSpscQueue;
+
+    explicit PopAwaiter(AsyncSpscQueue* queue) : queue_(queue) {}
+
+    AsyncSpscQueue* queue_;
+    T value_{};
+    bool popped_ = false;
+  };
+
+  /// @brief Constructs an empty queue.
+  /// @param executor Resumes the consumer coroutine when push() wakes it.
+  explicit AsyncSpscQueue(Executor executor = Executor())
+      : asymmetric_(detail::enable_asymmetric_fence()), executor_(std::move(executor)) {}
+
+  AsyncSpscQueue(const AsyncSpscQueue&) = delete;
+  AsyncSpscQueue& operator=(const AsyncSpscQueue&) = delete;
+
+  /// @brief Pushes a value and resumes the consumer coroutine if it is suspended.
+  /// @param value The value to push (copied).
+  /// @return true if the value was added, false if the queue is full.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] bool push(const T& value) {
+    if (!queue_.push(value))
+      return false;
+    detail::light_fence(asymmetric_);
+    if (waiter_.load(std::memory_order_relaxed) != nullptr) {
+      if (void* waiter = waiter_.exchange(nullptr, std::memory_order_acq_rel))
+        executor_(std::coroutine_handle<>::from_address(waiter));
+    }
+    return true;
+  }
+
+  /// @brief Returns an awaitable that yields the next value, suspending while empty.
+  /// This method is safe to call from the consumer coroutine only.
+  [[nodiscard]] PopAwaiter pop_async() { return PopAwaiter(this); }
+
+  /// @brief Pops a value without suspending.
+  /// @return true if a value was popped, false if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] bool pop(T& value) { return queue_.pop(value); }
+
+  /// @brief Returns the maximum number of elements the queue can hold.
+  size_t capacity() const { return queue_.capacity(); }
+
+  /// @brief Checks if the queue is empty.
+  [[nodiscard]] bool empty() const { return queue_.empty(); }
+
+  /// @brief Checks if the queue is full.
+  [[nodiscard]] bool full() const { return queue_.full(); }
+
+ private:
+  SpscQueue<T, N> queue_;
+  alignas(CACHE_LINE_SIZE) std::atomic<void*> waiter_{nullptr}; // Suspended consumer, if any
+  const bool asymmetric_; // membarrier() available: push() needs no hardware fence
+  Executor executor_;
+};
+
+} // namespace loon
@@ -0,0 +1,206 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file broadcast.hpp
+/// @brief Disruptor-style single-producer multicast ring with sequence barriers.
+
+#include <loon/spsc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace loon {
+
+/// @brief A single-producer ring where every consumer sees every message (SPMC broadcast).
+///
+/// Each message is written once and read by all consumers from the same slot, instead of
+/// being copied into one SpscQueue per consumer. Every consumer tracks its own read
+/// sequence; the producer gates on the slowest consumer, so a slot is only reused once
+/// all consumers are past it. Consumers can be chained: a consumer created with
+/// dependencies only sees a message after all of them have released it (a sequence
+/// barrier), e.g. a recorder that must run after risk and strategy.
+///
+/// Consumers must be added before the producer starts publishing. Each Consumer handle
+/// must be used by exactly one thread.
+///
+/// @tparam T The element type to store.
+/// @tparam N The ring capacity (must be > 0).
+/// @par Example
+/// @code
+/// loon::BroadcastRing<Tick, 1024> ring;
+/// auto& risk = ring.add_consumer();
+/// auto& strategy = ring.add_consumer();
+/// auto& recorder = ring.add_consumer({&risk, &strategy});  // runs after both
+///
+/// ring.push(tick);  // producer thread
+///
+/// Tick t;
+/// if (risk.pop(t)) {  // risk thread
+///     // use t
+/// }
+/// @endcode
+template <typename T, size_t N>
+class BroadcastRing {
+  static_assert(N > 0, "BroadcastRing capacity must be greater than 0");
+  static_assert(std::atomic<size_t>::is_always_lock_free,
+                "BroadcastRing requires lock-free atomics");
+
+ public:
+  using value_type = T;
+
+  /// @brief A consumer's view of the ring, with its own read sequence.
+  class Consumer {
+   public:
+    Consumer(const Consumer&) = delete;
+    Consumer& operator=(const Consumer&) = delete;
+
+    /// @brief Pops the next message for this consumer.
+    /// @param value The message (output, copied).
+    /// @return true if a message was read, false if none is available yet.
+    [[nodiscard]] bool pop(T& value) {
+      auto read = sequence_.load(std::memory_order_relaxed);
+      if (read == limit_cache_ && !refresh(read))
+        return false;
+      value = ring_->slot(read);
+      sequence_.store(read + 1, std::memory_order_release);
+      return true;
+    }
+
+    /// @brief Returns the next message in place without releasing it.
+    ///
+    /// The reference stays valid until release() is called.
+    /// @return A reference to the slot, or std::nullopt if no message is available yet.
+    [[nodiscard]] std::optional<std::reference_wrapper<const T>> front() {
+      auto read = sequence_.load(std::memory_order_relaxed);
+      if (read == limit_cache_ && !refresh(read))
+        return std::nullopt;
+      return std::cref(ring_->slot(read));
+    }
+
+    /// @brief Releases the message returned by the last successful front().
+    void release() {
+      auto read = sequence_.load(std::memory_order_relaxed);
+      sequence_.store(read + 1, std::memory_order_release);
+    }
+
+    /// @brief Returns how many messages this consumer can read right now.
+    [[nodiscard]] size_t available() {
+      auto read = sequence_.load(std::memory_order_relaxed);
+      refresh(read);
+      return limit_cache_ - read;
+    }
+
+   private:
+    friend class BroadcastRing;
+
+    Consumer(BroadcastRing* ring, std::vector<const Consumer*> depends_on, size_t start)
+        : sequence_(start), limit_cache_(start), ring_(ring), depends_on_(std::move(depends_on)) {}
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> sequence_; // Next sequence to read
+    alignas(CACHE_LINE_SIZE) size_t limit_cache_;           // Cached barrier: readable up to
+    BroadcastRing* ring_;
+    std::vector<const Consumer*> depends_on_;
+
+    // Reloads the barrier: the producer cursor, capped by every dependency's sequence.
+    bool refresh(size_t read) {
+      auto limit = ring_->published_.load(std::memory_order_acquire);
+      for (const auto* dependency : depends_on_) {
+        limit = std::min(limit, dependency->sequence_.load(std::memory_order_acquire));
+      }
+      limit_cache_ = limit;
+      return limit != read;
+    }
+  };
+
+  /// @brief Constructs an empty ring with no consumers.
+  BroadcastRing() = default;
+
+  BroadcastRing(const BroadcastRing&) = delete;
+  BroadcastRing& operator=(const BroadcastRing&) = delete;
+
+  /// @brief Registers a consumer. Must be called before the producer starts publishing.
+  /// @param depends_on Consumers that must release a message before this one sees it.
+  /// @return The consumer handle, owned by the ring.
+  Consumer& add_consumer(std::initializer_list<const Consumer*> depends_on = {}) {
+    const auto start = published_.load(std::memory_order_relaxed);
+    consumers_.push_back(std::unique_ptr<Consumer>(new Consumer(this, depends_on, start)));
+    gate_cache_ = start;
+    return *consumers_.back();
+  }
+
+  /// @brief Publishes a message to all consumers.
+  /// @param value The message (copied).
+  /// @return true if published, false if the slowest consumer has not freed a slot yet.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] bool push(const T& value) {
+    auto slot = try_reserve();
+    if (!slot)
+      return false;
+    slot->get() = value;
+    commit();
+    return true;
+  }
+
+  /// @brief Reserves the next slot so the producer can build a message in place.
+  /// @return A reference to the slot, or std::nullopt if the ring is full.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] std::optional<std::reference_wrapper<T>> try_reserve() {
+    auto write = published_.load(std::memory_order_relaxed);
+    if (write - gate_cache_ == N) {
+      gate_cache_ = slowest(write);
+      if (write - gate_cache_ == N)
+        return std::nullopt;
+    }
+    return std::ref(slot(write));
+  }
+
+  /// @brief Publishes the slot returned by the last successful try_reserve().
+  /// This method is safe to call from the producer thread only.
+  void commit() {
+    auto write = published_.load(std::memory_order_relaxed);
+    published_.store(write + 1, std::memory_order_release);
+  }
+
+  /// @brief Returns the ring capacity.
+  size_t capacity() const { return N; }
+
+  /// @brief Returns the number of registered consumers.
+  size_t consumers() const { return consumers_.size(); }
+
+ private:
+  T slots_[N];
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> published_{0}; // Producer cursor
+  alignas(CACHE_LINE_SIZE) size_t gate_cache_{0};             // Producer's cache of slowest
+  std::vector<std::unique_ptr<Consumer>> consumers_;
+
+  T& slot(size_t i) {
+    if constexpr (std::has_single_bit(N)) {
+      return slots_[i & (N - 1)];
+    } else {
+      return slots_[i % N];
+    }
+  }
+
+  // Returns the sequence of the slowest consumer, or write when there are none.
+  size_t slowest(size_t write) const {
+    auto slowest = write;
+    for (const auto& consumer : consumers_) {
+      const auto sequence = consumer->sequence_.load(std::memory_order_acquire);
+      if (write - sequence > write - slowest)
+        slowest = sequence;
+    }
+    return slowest;
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,343 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file clock_cache.hpp
+/// @brief Read-mostly concurrent cache with lock-free reads and CLOCK eviction.
+
+#include <loon/spsc.hpp>
+#include <loon/wait.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+namespace loon {
+
+/// @brief A fixed-capacity concurrent cache whose reads take no lock.
+///
+/// An LRU must relink its recency list on every get(), so even a ShardedLRU takes a lock
+/// per read. ClockCache replaces the list with CLOCK: each entry has a reference bit
+/// that a hit sets, and eviction sweeps a hand over the entries, clearing set bits and
+/// evicting the first entry whose bit is already clear. An entry that was read since the
+/// hand last passed it gets a second chance, which approximates LRU.
+///
+/// get() and exists() are lock-free and write no shared memory, except to set a clear
+/// reference bit, so hot keys stay in every reader's cache. Keys are indexed by an
+/// open-addressing table whose slots are atomics holding 32 hash bits and an entry index.
+/// Each entry is guarded by its own sequence counter, as in Seqlock: a reader copies the
+/// key and value between two reads of the counter and retries if a writer overlapped.
+///
+/// put() and remove() serialize on one lock. Removed keys leave tombstones, so readers
+/// never miss a key that is still present. When tombstones fill a quarter of the table,
+/// the writer rebuilds the index into a second table and publishes it by bumping a
+/// generation counter. Readers check the generation after a lookup and retry if the
+/// table they probed was rebuilt under them. Neither table is ever freed while the cache
+/// lives, so readers need no memory reclamation.
+///
+/// K and V must be trivially copyable, since readers may copy an entry that is being
+/// overwritten and then discard the copy. ThreadSanitizer reports that overlap between
+/// write() and read_entry() as a data race, as it does for Seqlock; the reader never uses
+/// a copy that a writer overlapped.
+///
+/// @tparam K Key type (trivially copyable, hashable with Hash, equality comparable)
+/// @tparam V Value type (trivially copyable, copied out by get())
+/// @tparam Lock Lock serializing writers: std::mutex or SpinLock
+/// @tparam Hash Hash function for K
+///
+/// @code
+/// loon::ClockCache<uint64_t, Quote> cache(1 << 16);
+/// cache.put(instrument_id, quote);            // any thread, locked
+/// if (auto quote = cache.get(instrument_id)) {  // any thread, lock-free
+///     use(*quote);
+/// }
+/// @endcode
+template <typename K, typename V, typename Lock = std::mutex, typename Hash = std::hash<K>>
+class ClockCache {
+  static_assert(std::is_trivially_copyable_v<K>, "ClockCache requires trivially copyable K");
+  static_assert(std::is_trivially_copyable_v<V>, "ClockCache requires trivially copyable V");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "ClockCache requires lock-free atomics");
+
+ public:
+  /// @brief Constructs an empty cache.
+  /// @param capacity Maximum number of entries (must be > 0 and < UINT32_MAX - 1).
+  explicit ClockCache(uint32_t capacity)
+      : capacity_(capacity), mask_(std::bit_ceil(std::max<size_t>(2 * size_t{capacity}, 16)) - 1),
+        entries_(std::make_unique<Entry[]>(capacity)),
+        tables_{std::make_unique<Slot[]>(mask_ + 1), std::make_unique<Slot[]>(mask_ + 1)} {
+    free_.reserve(capacity);
+    for (uint32_t i = capacity; i > 0; --i) {
+      free_.push_back(i - 1);
+    }
+  }
+
+  ClockCache(const ClockCache&) = delete;
+  ClockCache& operator=(const ClockCache&) = delete;
+
+  /// @brief Retrieves a copy of a value and marks the entry as referenced. Lock-free.
+  /// @param key The key to look up.
+  /// @return A copy of the value if found, std::nullopt otherwise.
+  /// This method is safe to call from any thread.
+  std::optional<V> get(const K& key) {
+    V value;
+    const auto entry = read(key, &value);
+    if (entry == NO_ENTRY)
+      return std::nullopt;
+    // Only write when the bit is clear, so hot entries are not bounced between cores
+    auto& referenced = entries_[entry].referenced;
+    if (!referenced.load(std::memory_order_relaxed))
+      referenced.store(1, std::memory_order_relaxed);
+    return value;
+  }
+
+  /// @brief Checks if a key exists, without marking it as referenced. Lock-free.
+  /// @param key The key to check.
+  /// @return true if the key exists, false otherwise.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] bool exists(const K& key) const { return read(key, nullptr) != NO_ENTRY; }
+
+  /// @brief Inserts or updates a key-value pair.
+  ///
+  /// Updating marks the entry as referenced. A new entry starts unreferenced; if the
+  /// cache is full, the CLOCK hand picks the entry to evict.
+  ///
+  /// @param key The key to insert or update.
+  /// @param value The value to associate with the key.
+  /// This method is safe to call from any thread.
+  void put(const K& key, const V& value) {
+    std::lock_guard guard(lock_);
+    const auto h = hash(key);
+    auto* table = active();
+    const auto slot = find(table, key, h);
+    if (slot != NO_SLOT) {
+      const auto entry = entry_of(table[slot].load(std::memory_order_relaxed));
+      write(entry, key, value);
+      entries_[entry].referenced.store(1, std::memory_order_relaxed);
+      return;
+    }
+
+    uint32_t entry;
+    if (free_.empty()) {
+      entry = evict(table);
+    } else {
+      entry = free_.back();
+      free_.pop_back();
+      count_.store(count_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+    write(entry, key, value);
+    entries_[entry].referenced.store(0, std::memory_order_relaxed);
+    if (insert(table, h, entry))
+      ++used_slots_;
+    if (used_slots_ > (mask_ + 1) / 4 * 3)
+      rebuild();
+  }
+
+  /// @brief Removes a key-value pair. Has no effect if the key does not exist.
+  /// @param key The key to remove.
+  /// This method is safe to call from any thread.
+  void remove(const K& key) {
+    std::lock_guard guard(lock_);
+    auto* table = active();
+    const auto slot = find(table, key, hash(key));
+    if (slot == NO_SLOT)
+      return;
+    const auto entry = entry_of(table[slot].load(std::memory_order_relaxed));
+    table[slot].store(TOMBSTONE, std::memory_order_release);
+    free_.push_back(entry);
+    count_.store(count_.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+  }
+
+  /// @brief Returns the number of entries. Exact only while no writer is running.
+  [[nodiscard]] size_t size() const { return count_.load(std::memory_order_relaxed); }
+
+  /// @brief Returns the maximum number of entries.
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+ private:
+  struct Entry {
+    std::atomic<uint32_t> version{0};   // Odd while a writer changes the key or value
+    std::atomic<uint8_t> referenced{0}; // CLOCK reference bit, set by hits
+    K key{};
+    V value{};
+  };
+
+  // An index slot: 0 when empty, 1 for a tombstone, otherwise the key's upper 32 hash
+  // bits and its entry index + 2.
+  using Slot = std::atomic<uint64_t>;
+  static constexpr uint64_t EMPTY = 0;
+  static constexpr uint64_t TOMBSTONE = 1;
+
+  static constexpr uint32_t NO_ENTRY = UINT32_MAX;
+  static constexpr size_t NO_SLOT = SIZE_MAX;
+
+  // Read by every operation, written only at construction and on a rebuild
+  const uint32_t capacity_;
+  const size_t mask_; ///< Table slots - 1 (a power of two, at least 2 * capacity)
+  const std::unique_ptr<Entry[]> entries_;
+  const std::unique_ptr<Slot[]> tables_[2];
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> generation_{0}; ///< Active table: & 1
+
+  // Writer state
+  alignas(CACHE_LINE_SIZE) Lock lock_;
+  std::atomic<size_t> count_{0}; ///< Entries in use; atomic only so size() can read it
+  std::vector<uint32_t> free_;   ///< Unused entries
+  uint32_t hand_ = 0;            ///< CLOCK hand: next entry considered for eviction
+  size_t used_slots_ = 0;        ///< Full and tombstone slots of the active table
+
+  // Spreads the hash over all 64 bits; std::hash is the identity for integers.
+  static uint64_t hash(const K& key) {
+    uint64_t h = static_cast<uint64_t>(Hash{}(key)) * 0x9e3779b97f4a7c15;
+    return h ^ (h >> 32);
+  }
+
+  static uint64_t make_slot(uint64_t h, uint32_t entry) {
+    return (h & 0xffffffff00000000) | (uint64_t{entry} + 2);
+  }
+
+  static uint32_t entry_of(uint64_t slot) { return static_cast<uint32_t>(slot) - 2; }
+
+  static bool same_tag(uint64_t slot, uint64_t h) { return (slot >> 32) == (h >> 32); }
+
+  Slot* active() const {
+    return tables_[generation_.load(std::memory_order_relaxed) & 1].get();
+  }
+
+  // Reader side: looks key up and copies its value into value, if not null. Retries if
+  // the index was rebuilt during the probe. Returns the entry, or NO_ENTRY.
+  uint32_t read(const K& key, V* value) const {
+    const auto h = hash(key);
+    for (;;) {
+      const auto generation = generation_.load(std::memory_order_acquire);
+      const auto entry = probe(tables_[generation & 1].get(), key, h, value);
+      std::atomic_thread_fence(std::memory_order_acquire); // Probe before the re-check
+      if (generation_.load(std::memory_order_relaxed) == generation)
+        return entry;
+    }
+  }
+
+  uint32_t probe(const Slot* table, const K& key, uint64_t h, V* value) const {
+    for (size_t i = 0, pos = h & mask_; i <= mask_; ++i, pos = (pos + 1) & mask_) {
+      const auto slot = table[pos].load(std::memory_order_acquire);
+      if (slot == EMPTY)
+        return NO_ENTRY;
+      if (slot == TOMBSTONE || !same_tag(slot, h))
+        continue;
+      const auto entry = entry_of(slot);
+      if (read_entry(entries_[entry], key, value))
+        return entry;
+    }
+    return NO_ENTRY;
+  }
+
+  // Copies the entry between two reads of its version, seqlock style. Returns whether it
+  // held key; a writer may have reused it for another key since the slot was read.
+  // The copies go through memcpy into locals, as in Seqlock, so the compiler cannot
+  // assume they are stable, and the key is only compared once the copy is known to be
+  // consistent.
+  static bool read_entry(const Entry& e, const K& key, V* value) {
+    K stored;
+    V copied;
+    for (;;) {
+      const auto before = e.version.load(std::memory_order_acquire);
+      if (before & 1) {
+        cpu_relax();
+        continue;
+      }
+      std::memcpy(&stored, &e.key, sizeof(K));
+      if (value != nullptr)
+        std::memcpy(&copied, &e.value, sizeof(V));
+      std::atomic_thread_fence(std::memory_order_acquire); // Copy before the second read
+      if (e.version.load(std::memory_order_relaxed) != before)
+        continue;
+      if (!(stored == key))
+        return false;
+      if (value != nullptr)
+        *value = copied;
+      return true;
+    }
+  }
+
+  // Writer side: returns the slot of table holding key, or NO_SLOT.
+  size_t find(const Slot* table, const K& key, uint64_t h) const {
+    for (size_t pos = h & mask_;; pos = (pos + 1) & mask_) {
+      const auto slot = table[pos].load(std::memory_order_relaxed);
+      if (slot == EMPTY)
+        return NO_SLOT;
+      if (slot != TOMBSTONE && same_tag(slot, h) && entries_[entry_of(slot)].key == key)
+        return pos;
+    }
+  }
+
+  // Indexes entry in the first empty or tombstone slot of its probe sequence. Returns
+  // true if the slot was empty. Release stores, so a reader that sees the slot also sees
+  // the entry and, in a rebuilt table, the generation that made it inactive.
+  bool insert(Slot* table, uint64_t h, uint32_t entry) {
+    for (size_t pos = h & mask_;; pos = (pos + 1) & mask_) {
+      const auto slot = table[pos].load(std::memory_order_relaxed);
+      if (slot == EMPTY || slot == TOMBSTONE) {
+        table[pos].store(make_slot(h, entry), std::memory_order_release);
+        return slot == EMPTY;
+      }
+    }
+  }
+
+  void write(uint32_t entry, const K& key, const V& value) {
+    auto& e = entries_[entry];
+    const auto version = e.version.load(std::memory_order_relaxed);
+    e.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // Odd version before the copy
+    std::memcpy(&e.key, &key, sizeof(K));
+    std::memcpy(&e.value, &value, sizeof(V));
+    e.version.store(version + 2, std::memory_order_release);
+  }
+
+  // Sweeps the hand, clearing reference bits, until it finds an unreferenced entry, then
+  // unindexes it. Called only when every entry is in use.
+  uint32_t evict(Slot* table) {
+    for (;;) {
+      const auto entry = hand_;
+      hand_ = hand_ + 1 == capacity_ ? 0 : hand_ + 1;
+      auto& e = entries_[entry];
+      if (e.referenced.load(std::memory_order_relaxed)) {
+        e.referenced.store(0, std::memory_order_relaxed);
+        continue;
+      }
+      table[find(table, e.key, hash(e.key))].store(TOMBSTONE, std::memory_order_release);
+      return entry;
+    }
+  }
+
+  // Re-indexes every entry into the inactive table without tombstones, then makes it
+  // active. Readers still probing the old table see the new generation and retry.
+  void rebuild() {
+    const auto generation = generation_.load(std::memory_order_relaxed);
+    const Slot* from = tables_[generation & 1].get();
+    Slot* to = tables_[(generation + 1) & 1].get();
+    for (size_t i = 0; i <= mask_; ++i) {
+      to[i].store(EMPTY, std::memory_order_release);
+    }
+    used_slots_ = 0;
+    for (size_t i = 0; i <= mask_; ++i) {
+      const auto slot = from[i].load(std::memory_order_relaxed);
+      if (slot != EMPTY && slot != TOMBSTONE) {
+        const auto entry = entry_of(slot);
+        insert(to, hash(entries_[entry].key), entry);
+        ++used_slots_;
+      }
+    }
+    generation_.store(generation + 1, std::memory_order_release);
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,159 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file fan_in.hpp
+/// @brief Readiness-bitmap poller for a consumer that drains many SpscQueues.
+
+#include <loon/spsc.hpp>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace loon {
+
+/// @brief One consumer draining many per-producer SpscQueues through a readiness bitmap.
+///
+/// Every producer gets its own SpscQueue and a bit in a shared bitmap. A push sets the
+/// bit only when it is not already set, so a busy producer adds a fence and one read of a
+/// shared line but no write. The consumer claims a whole 64-queue word at a time with one
+/// exchange, walks the set bits with countr_zero and drains each ready queue in place,
+/// never touching queues that are empty. The fence keeps a push that races with the
+/// consumer clearing its bit from being lost; it is paid on the producer threads so the
+/// single consumer stays cheap.
+///
+/// A queue that still holds values after a batch is re-armed, so one busy producer
+/// cannot starve the others.
+///
+/// @tparam T The element type to store.
+/// @tparam N The capacity of each producer's queue (must be > 0).
+/// @tparam MaxQueues The maximum number of producers.
+/// @par Example
+/// @code
+/// loon::FanInPoller<Order, 1024, 64> poller;
+/// auto& client = poller.add_producer();       // setup, once per client
+///
+/// client.push(order);                         // client thread
+///
+/// poller.poll([](size_t client, const Order& order) {  // consumer thread
+///     route(client, order);
+/// });
+/// @endcode
+template <typename T, size_t N, size_t MaxQueues = 64>
+class FanInPoller {
+  static_assert(MaxQueues > 0, "FanInPoller must allow at least one queue");
+
+ public:
+  using value_type = T;
+
+  /// @brief A producer's queue; pushes mark it ready for the consumer.
+  class Producer {
+   public:
+    Producer(const Producer&) = delete;
+    Producer& operator=(const Producer&) = delete;
+
+    /// @brief Pushes a value and marks the queue ready.
+    /// @param value The value to push (copied).
+    /// @return true if the value was added, false if this producer's queue is full.
+    /// This method is safe to call from this producer's thread only.
+    [[nodiscard]] bool push(const T& value) {
+      if (!queue_.push(value))
+        return false;
+      // Pairs with the fence in poll(): either the consumer sees the value, or we see the
+      // cleared bit
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if ((ready_->load(std::memory_order_relaxed) & bit_) == 0)
+        ready_->fetch_or(bit_, std::memory_order_release);
+      return true;
+    }
+
+    /// @brief Returns the index passed to the poll() handler for this producer's values.
+    size_t index() const { return index_; }
+
+   private:
+    friend class FanInPoller;
+
+    Producer(std::atomic<uint64_t>* ready, size_t index)
+        : ready_(ready), bit_(uint64_t{1} << (index % 64)), index_(index) {}
+
+    SpscQueue<T, N> queue_;
+    std::atomic<uint64_t>* ready_;
+    uint64_t bit_;
+    size_t index_;
+  };
+
+  /// @brief Constructs a poller with no producers.
+  FanInPoller() = default;
+
+  FanInPoller(const FanInPoller&) = delete;
+  FanInPoller& operator=(const FanInPoller&) = delete;
+
+  /// @brief Registers a producer. Must be called before producers or the consumer start.
+  /// @return The producer handle, owned by the poller.
+  /// @throws std::length_error if MaxQueues producers are already registered.
+  Producer& add_producer() {
+    const size_t index = producers_.size();
+    if (index == MaxQueues)
+      throw std::length_error("FanInPoller: too many producers");
+    producers_.push_back(std::unique_ptr<Producer>(new Producer(&ready_[index / 64], index)));
+    return *producers_.back();
+  }
+
+  /// @brief Drains every ready queue, calling handler(index, value) for each value in place.
+  /// @param handler Called with the producer's index and a reference to the value, which
+  ///                is only valid during the call.
+  /// @param batch The maximum number of values taken from one queue per poll.
+  /// @return The number of values handled, 0 if no queue was ready.
+  /// This method is safe to call from the consumer thread only.
+  template <typename Handler>
+  size_t poll(Handler&& handler, size_t batch = 64) {
+    size_t handled = 0;
+    for (size_t w = 0; w < WORDS; ++w) {
+      if (ready_[w].load(std::memory_order_relaxed) == 0)
+        continue;
+      uint64_t ready = ready_[w].exchange(0, std::memory_order_acquire);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      while (ready != 0) {
+        const auto bit = std::countr_zero(ready);
+        ready &= ready - 1;
+        handled += drain(*producers_[w * 64 + bit], handler, batch);
+      }
+    }
+    return handled;
+  }
+
+  /// @brief Returns the capacity of each producer's queue.
+  size_t capacity() const { return N; }
+
+  /// @brief Returns the number of registered producers.
+  size_t producers() const { return producers_.size(); }
+
+ private:
+  static constexpr size_t WORDS = (MaxQueues + 63) / 64;
+
+  alignas(CACHE_LINE_SIZE) std::array<std::atomic<uint64_t>, WORDS> ready_{};
+  std::vector<std::unique_ptr<Producer>> producers_;
+
+  // Handles up to batch values from one queue, re-arming it if values are left over.
+  template <typename Handler>
+  size_t drain(Producer& producer, Handler& handler, size_t batch) {
+    for (size_t count = 0; count < batch; ++count) {
+      auto value = producer.queue_.front();
+      if (!value)
+        return count;
+      handler(producer.index_, value->get());
+      producer.queue_.release();
+    }
+    producer.ready_->fetch_or(producer.bit_, std::memory_order_relaxed);
+    return batch;
+  }
+};
+
+} // namespace loon
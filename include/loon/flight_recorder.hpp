@@ -0,0 +1,229 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file flight_recorder.hpp
+/// @brief Lock-free multi-writer ring that overwrites its oldest entries, for always-on tracing.
+
+#include <loon/spsc.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include <unistd.h>
+
+namespace loon {
+
+/// @brief A multi-writer ring that keeps the last N entries and never blocks a writer.
+///
+/// Like an override-mode RingBuffer, a full FlightRecorder overwrites its oldest entry,
+/// but any number of threads can push concurrently. A writer claims the next sequence
+/// number with a single fetch_add and writes slot sequence % N. Each slot carries a stamp
+/// derived from the sequence number: odd while a writer copies into it, even once the
+/// entry is complete. Readers copy an entry between two reads of the stamp, seqlock style,
+/// so an entry that was torn or overwritten in the meantime is detected and skipped.
+///
+/// A writer that finds its slot still owned by a writer from the previous lap (stalled
+/// for a whole lap of the ring) drops its entry rather than wait; lost() counts these.
+///
+/// dump() writes a binary snapshot of every intact entry to a file descriptor. It only
+/// calls write(2) and uses a fixed stack buffer, so it may run in a crash handler.
+/// T must be trivially copyable, since readers may copy an entry that is being written.
+///
+/// @tparam T The entry type (trivially copyable).
+/// @tparam N The number of entries kept (must be > 0; a power of two wraps with a mask).
+/// @par Example
+/// @code
+/// static loon::FlightRecorder<TraceEvent, 1 << 20> trace;
+/// trace.push({now(), EventKind::OrderSent, order_id});  // from any thread
+///
+/// void on_crash(int) { (void)trace.dump(crash_fd); }
+/// @endcode
+template <typename T, size_t N>
+class FlightRecorder {
+  static_assert(std::is_trivially_copyable_v<T>, "FlightRecorder requires trivially copyable T");
+  static_assert(N > 0, "FlightRecorder capacity must be greater than 0");
+  static_assert(std::atomic<uint64_t>::is_always_lock_free,
+                "FlightRecorder requires lock-free atomics");
+
+ public:
+  using value_type = T;
+
+  /// @brief Format version written in DumpHeader; bumped whenever the layout changes.
+  static constexpr uint32_t VERSION = 1;
+
+  /// @brief Magic number opening every dump ("loonFREC").
+  static constexpr uint64_t MAGIC = 0x6c6f6f6e46524543;
+
+  /// @brief Opens a dump; followed by a Record per intact entry, oldest first.
+  struct DumpHeader {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size; // sizeof(Record)
+    uint64_t capacity;    // N
+    uint64_t written;     // Sequence numbers claimed when the dump started
+    uint64_t lost;        // Entries dropped by writers that found their slot busy
+  };
+
+  /// @brief One entry as written by dump(). Gaps in sequence mark skipped entries.
+  struct Record {
+    uint64_t sequence;
+    T value;
+  };
+
+  /// @brief Allocates N empty slots on the heap.
+  FlightRecorder() : slots_(std::make_unique<Slot[]>(N)) {}
+
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  /// @brief Appends an entry, overwriting the oldest one once N entries were pushed.
+  ///
+  /// Lock-free: one fetch_add to claim a sequence number and one uncontended CAS on the
+  /// slot's stamp, unless a writer stalled for a whole lap still owns the slot.
+  /// @param value The entry to record (copied).
+  /// This method is safe to call from any thread.
+  void push(const T& value) {
+    const uint64_t sequence = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index(sequence)];
+    const uint64_t writing = 2 * sequence + 1;
+    uint64_t stamp = slot.stamp.load(std::memory_order_relaxed);
+    do {
+      // Busy (odd) or already holding a later lap: drop rather than wait
+      if ((stamp & 1) != 0 || stamp > writing) {
+        lost_.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    } while (!slot.stamp.compare_exchange_weak(stamp, writing, std::memory_order_acquire,
+                                               std::memory_order_relaxed));
+    std::atomic_thread_fence(std::memory_order_release); // Odd stamp before the copy
+    std::memcpy(&slot.value, &value, sizeof(T));
+    slot.stamp.store(writing + 1, std::memory_order_release);
+  }
+
+  /// @brief Reads the entry with the given sequence number, if it is still intact.
+  /// @param sequence The sequence number, counted from 0 across all writers.
+  /// @param value The entry (output, copied). Left unspecified on failure.
+  /// @return false if the entry was not written yet, is being written, was dropped or
+  ///         has been overwritten.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] bool read(uint64_t sequence, T& value) const {
+    const Slot& slot = slots_[index(sequence)];
+    const uint64_t written = 2 * sequence + 2;
+    if (slot.stamp.load(std::memory_order_acquire) != written)
+      return false;
+    std::memcpy(&value, &slot.value, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire); // Copy before the second read
+    return slot.stamp.load(std::memory_order_relaxed) == written;
+  }
+
+  /// @brief Calls f(sequence, value) for every intact entry among the last N, oldest first.
+  /// @return The number of entries visited.
+  /// This method is safe to call from any thread.
+  template <typename F>
+  size_t for_each(F&& f) const {
+    const uint64_t end = head_.load(std::memory_order_acquire);
+    size_t visited = 0;
+    T value;
+    for (uint64_t sequence = end > N ? end - N : 0; sequence < end; ++sequence) {
+      if (read(sequence, value)) {
+        f(sequence, static_cast<const T&>(value));
+        ++visited;
+      }
+    }
+    return visited;
+  }
+
+  /// @brief Writes a DumpHeader followed by a Record for every intact entry, oldest first.
+  ///
+  /// Writers may keep pushing during the dump. Entries they overwrite before the dump
+  /// reaches them are skipped and show up as gaps in the sequence numbers. Uses only
+  /// write(2) and a fixed stack buffer and does not throw, so it is safe to call from a
+  /// signal handler.
+  /// @param fd A file descriptor open for writing.
+  /// @return The number of records written, or -1 with errno set if a write failed.
+  [[nodiscard]] ssize_t dump(int fd) const noexcept {
+    const DumpHeader header{MAGIC,
+                            VERSION,
+                            static_cast<uint32_t>(sizeof(Record)),
+                            N,
+                            head_.load(std::memory_order_acquire),
+                            lost_.load(std::memory_order_relaxed)};
+    if (!write_all(fd, &header, sizeof(header)))
+      return -1;
+
+    Record batch[DUMP_BATCH]{};
+    size_t pending = 0;
+    ssize_t records = 0;
+    const uint64_t end = header.written;
+    for (uint64_t sequence = end > N ? end - N : 0; sequence < end; ++sequence) {
+      if (!read(sequence, batch[pending].value))
+        continue;
+      batch[pending].sequence = sequence;
+      if (++pending == DUMP_BATCH) {
+        if (!write_all(fd, batch, sizeof(batch)))
+          return -1;
+        records += static_cast<ssize_t>(pending);
+        pending = 0;
+      }
+    }
+    if (!write_all(fd, batch, pending * sizeof(Record)))
+      return -1;
+    return records + static_cast<ssize_t>(pending);
+  }
+
+  /// @brief Returns the number of sequence numbers claimed so far, i.e. pushes started.
+  [[nodiscard]] uint64_t written() const { return head_.load(std::memory_order_acquire); }
+
+  /// @brief Returns the number of entries dropped because their slot was still busy.
+  [[nodiscard]] uint64_t lost() const { return lost_.load(std::memory_order_relaxed); }
+
+  /// @brief Returns the number of entries kept.
+  [[nodiscard]] size_t capacity() const { return N; }
+
+ private:
+  // Records buffered per write(2) call during a dump, about 4 KiB
+  static constexpr size_t DUMP_BATCH = std::max<size_t>(1, 4096 / sizeof(Record));
+
+  struct Slot {
+    std::atomic<uint64_t> stamp{0}; // 2 * sequence + 1 while writing, + 2 once written
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> head_{0}; // Next sequence number
+  alignas(CACHE_LINE_SIZE) std::atomic<uint64_t> lost_{0};
+
+  static constexpr size_t index(uint64_t sequence) {
+    if constexpr (std::has_single_bit(N)) {
+      return static_cast<size_t>(sequence & (N - 1));
+    } else {
+      return static_cast<size_t>(sequence % N);
+    }
+  }
+
+  // Writes the whole buffer, resuming after partial writes and EINTR.
+  static bool write_all(int fd, const void* data, size_t size) {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    while (size > 0) {
+      const ssize_t n = ::write(fd, bytes, size);
+      if (n < 0) {
+        if (errno == EINTR)
+          continue;
+        return false;
+      }
+      bytes += n;
+      size -= static_cast<size_t>(n);
+    }
+    return true;
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,169 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file instrument.hpp
+/// @brief Optional dwell-time and occupancy instrumentation policies for the queues.
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#ifndef CACHE_LINE_SIZE
+#if defined(__cpp_lib_hardware_interference_size)
+#define CACHE_LINE_SIZE std::hardware_destructive_interference_size
+#else
+#define CACHE_LINE_SIZE 64
+#endif
+#endif
+
+namespace loon {
+
+/// @brief Reads the CPU timestamp counter (RDTSC on x86, steady_clock nanoseconds elsewhere).
+inline uint64_t read_tsc() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+/// @brief Default instrumentation policy: every hook is empty and compiles away.
+///
+/// Used as a [[no_unique_address]] member, it adds no storage and no instructions to
+/// SpscQueue or RingBuffer.
+struct NoInstrumentation {
+  static constexpr bool enabled = false;
+
+  constexpr explicit NoInstrumentation(size_t /*capacity*/) {}
+
+  void on_push(size_t /*slot*/) {}
+  void on_pop(size_t /*slot*/, size_t /*occupancy*/) {}
+};
+
+/// @brief Instrumentation policy recording how long elements wait and how full the queue gets.
+///
+/// on_push() stamps the slot with read_tsc(); on_pop() records the elapsed ticks into a
+/// log-linear histogram (16 linear sub-buckets per power of two, so every bucket is
+/// within 6.25% of its value) and tracks the highest occupancy seen. The producer only
+/// writes its slot stamps and the consumer only writes the statistics, so the policy
+/// keeps SpscQueue's single-writer-per-line layout. snapshot() and reset() may be called
+/// from any thread.
+///
+/// Dwell times are in timestamp counter ticks; divide by the TSC frequency for seconds.
+///
+/// @par Example
+/// @code
+/// loon::SpscQueue<Order, 1024, loon::DwellInstrumentation> orders;
+/// // ... traffic ...
+/// auto stats = orders.instrumentation().snapshot();
+/// log("p99 dwell", stats.percentile(0.99), "ticks, high water", stats.high_water);
+/// orders.instrumentation().reset();
+/// @endcode
+class DwellInstrumentation {
+ public:
+  static constexpr bool enabled = true;
+
+  /// @brief Number of linear sub-buckets per power of two, as a bit count.
+  static constexpr unsigned SUB_BUCKET_BITS = 4;
+  /// @brief Total number of histogram buckets, covering the full 64-bit range.
+  static constexpr size_t BUCKETS = (64 - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS;
+
+  /// @brief A copy of the statistics at one point in time.
+  struct Snapshot {
+    std::array<uint64_t, BUCKETS> counts{}; ///< Elements per dwell bucket.
+    uint64_t total = 0;                     ///< Elements recorded.
+    size_t high_water = 0;                  ///< Highest occupancy seen at pop time.
+
+    /// @brief Returns an upper bound on the dwell time of the given fraction of elements.
+    /// @param fraction The percentile as a fraction (e.g. 0.99).
+    /// @return The upper edge of the bucket holding that percentile, in ticks; 0 if empty.
+    [[nodiscard]] uint64_t percentile(double fraction) const {
+      if (total == 0)
+        return 0;
+      const auto target = static_cast<uint64_t>(fraction * static_cast<double>(total));
+      uint64_t seen = 0;
+      for (size_t b = 0; b < BUCKETS; ++b) {
+        seen += counts[b];
+        if (seen > target || seen == total)
+          return b + 1 == BUCKETS ? UINT64_MAX : bucket_floor(b + 1) - 1;
+      }
+      return UINT64_MAX;
+    }
+  };
+
+  /// @brief Allocates one timestamp per slot.
+  /// @param capacity The number of slots in the instrumented queue.
+  explicit DwellInstrumentation(size_t capacity)
+      : stamps_(std::make_unique<uint64_t[]>(capacity)) {}
+
+  /// @brief Stamps a slot with the current time. Called by the producer before publishing.
+  void on_push(size_t slot) { stamps_[slot] = read_tsc(); }
+
+  /// @brief Records a slot's dwell time. Called by the consumer before releasing the slot.
+  /// @param slot The slot being popped.
+  /// @param occupancy The number of elements the consumer sees, including this one.
+  void on_pop(size_t slot, size_t occupancy) {
+    counts_[bucket(read_tsc() - stamps_[slot])].fetch_add(1, std::memory_order_relaxed);
+    if (occupancy > high_water_.load(std::memory_order_relaxed))
+      high_water_.store(occupancy, std::memory_order_relaxed);
+  }
+
+  /// @brief Copies the current statistics.
+  [[nodiscard]] Snapshot snapshot() const {
+    Snapshot snapshot;
+    for (size_t b = 0; b < BUCKETS; ++b) {
+      snapshot.counts[b] = counts_[b].load(std::memory_order_relaxed);
+      snapshot.total += snapshot.counts[b];
+    }
+    snapshot.high_water = high_water_.load(std::memory_order_relaxed);
+    return snapshot;
+  }
+
+  /// @brief Clears the histogram and the high-water mark.
+  void reset() {
+    for (auto& count : counts_) {
+      count.store(0, std::memory_order_relaxed);
+    }
+    high_water_.store(0, std::memory_order_relaxed);
+  }
+
+  /// @brief Returns the histogram bucket holding a dwell time.
+  static constexpr size_t bucket(uint64_t ticks) {
+    constexpr uint64_t sub_buckets = uint64_t{1} << SUB_BUCKET_BITS;
+    if (ticks < sub_buckets)
+      return ticks;
+    const unsigned exponent = std::bit_width(ticks) - 1;
+    const uint64_t sub = (ticks >> (exponent - SUB_BUCKET_BITS)) & (sub_buckets - 1);
+    return ((exponent - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + sub;
+  }
+
+  /// @brief Returns the smallest dwell time that falls into a bucket.
+  static constexpr uint64_t bucket_floor(size_t bucket) {
+    constexpr size_t sub_buckets = size_t{1} << SUB_BUCKET_BITS;
+    if (bucket < sub_buckets)
+      return bucket;
+    const unsigned exponent = bucket / sub_buckets + SUB_BUCKET_BITS - 1;
+    const uint64_t sub = bucket % sub_buckets;
+    return (uint64_t{1} << exponent) | (sub << (exponent - SUB_BUCKET_BITS));
+  }
+
+ private:
+  std::unique_ptr<uint64_t[]> stamps_;                         // Producer-written
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> high_water_{0}; // Consumer-written
+  std::array<std::atomic<uint64_t>, BUCKETS> counts_{};
+};
+
+} // namespace loon
@@ -4,22 +4,80 @@
 #pragma once
 
 /// @file lru.hpp
-/// @brief Thread-safe LRU (Least Recently Used) cache implementation.
+/// @brief LRU (Least Recently Used) cache implementation. Not thread-safe; see ShardedLRU.
+#include <algorithm>
+#include <bit>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
 #include <optional>
-#include <unordered_map>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 namespace loon {
 
+namespace detail {
+
+// A group of 16 control bytes from an open-addressing table, matched all at once: with
+// SSE2 one compare and movemask, otherwise a byte loop the compiler can unroll.
+class ControlGroup {
+ public:
+  static constexpr size_t WIDTH = 16;
+
+  explicit ControlGroup(const int8_t* ctrl) {
+#if defined(__SSE2__)
+    bytes_ = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctrl));
+#else
+    std::copy_n(ctrl, WIDTH, bytes_);
+#endif
+  }
+
+  // Returns a bitmask with bit i set where control byte i equals value.
+  uint32_t match(int8_t value) const {
+#if defined(__SSE2__)
+    const auto equal = _mm_cmpeq_epi8(bytes_, _mm_set1_epi8(value));
+    return static_cast<uint32_t>(_mm_movemask_epi8(equal));
+#else
+    uint32_t mask = 0;
+    for (size_t i = 0; i < WIDTH; ++i) {
+      mask |= static_cast<uint32_t>(bytes_[i] == value) << i;
+    }
+    return mask;
+#endif
+  }
+
+ private:
+#if defined(__SSE2__)
+  __m128i bytes_;
+#else
+  int8_t bytes_[WIDTH];
+#endif
+};
+
+} // namespace detail
+
 /// @brief A Least Recently Used (LRU) cache with O(1) access and eviction.
 ///
 /// This cache maintains a fixed capacity and automatically evicts the least
 /// recently used entries when the capacity is exceeded. Both get() and put()
 /// operations update the recency of the accessed key.
 ///
-/// @tparam K Key type (must be hashable for std::unordered_map)
+/// Keys are indexed by an embedded open-addressing table rather than a node-based map.
+/// Each table slot holds a uint32_t node index plus a control byte with 7 bits of the
+/// key's hash, and keys are compared through the node, so every key is stored once.
+/// Lookups match 16 control bytes per step (SSE2 when available). The table is linear
+/// probed at a load factor of at most 1/2 and deletes by shifting later entries back,
+/// so eviction stays O(1) without tombstones.
+///
+/// LRU has no internal synchronization, and even get() modifies the recency list. To
+/// share a cache between threads, use ShardedLRU.
+///
+/// @tparam K Key type (must be hashable with Hash and equality comparable)
 /// @tparam V Value type
+/// @tparam Hash Hash function for K
 ///
 /// @code
 /// loon::LRU<std::string, int> cache(100);
@@ -28,13 +86,15 @@ namespace loon {
 ///     std::cout << val->get() << std::endl;
 /// }
 /// @endcode
-template <typename K, typename V>
+template <typename K, typename V, typename Hash = std::hash<K>>
 class LRU {
  public:
   /// @brief Constructs an LRU cache with the specified capacity.
-  /// @param size Maximum number of entries the cache can hold.
-  explicit LRU(uint32_t size) : capacity(size), store(size) {
-    lookup.reserve(size);
+  /// @param size Maximum number of entries the cache can hold (must be > 0).
+  explicit LRU(uint32_t size)
+      : capacity(size), store(size),
+        mask(std::bit_ceil(std::max<size_t>(2 * size_t{size}, GROUP)) - 1),
+        ctrl(mask + GROUP, EMPTY), slots(mask + 1) {
     for (uint32_t i = 0; i < size; ++i) {
       store[i].next = i + 1;
     }
@@ -48,13 +108,13 @@ class LRU {
   /// @param key The key to look up.
   /// @return A reference to the value if found, std::nullopt otherwise.
   std::optional<std::reference_wrapper<V>> get(const K& key) {
-    const auto it = lookup.find(key);
-    if (it == lookup.end())
+    const auto slot = find(key, hash(key));
+    if (slot == NO_SLOT)
       return std::nullopt;
 
-    set_mru(it->second);
+    set_mru(slots[slot]);
 
-    return std::ref(store[it->second].value);
+    return std::ref(store[slots[slot]].value);
   }
 
   /// @brief Inserts or updates a key-value pair in the cache.
@@ -66,17 +126,18 @@ class LRU {
   /// @param key The key to insert or update.
   /// @param value The value to associate with the key.
   void put(const K& key, const V& value) {
-    auto [it, inserted] = lookup.try_emplace(key);
-    if (inserted) { // key didnt exist
-      if (capacity < lookup.size()) {
+    const auto h = hash(key);
+    const auto slot = find(key, h);
+    if (slot == NO_SLOT) { // key didnt exist
+      if (count == capacity) {
         evict();
       }
 
-      auto idx = emplace_front(key, value);
-      it->second = idx;
+      insert(h, emplace_front(key, value));
+      ++count;
     } else {
-      store[it->second].value = value;
-      set_mru(it->second);
+      store[slots[slot]].value = value;
+      set_mru(slots[slot]);
     }
   }
 
@@ -86,7 +147,7 @@ class LRU {
   ///
   /// @param key The key to check.
   /// @return true if the key exists, false otherwise.
-  bool exists(const K& key) const { return lookup.find(key) != lookup.end(); }
+  bool exists(const K& key) const { return find(key, hash(key)) != NO_SLOT; }
 
   /// @brief Removes a key-value pair from the cache.
   ///
@@ -94,16 +155,20 @@ class LRU {
   ///
   /// @param key The key to remove.
   void remove(const K& key) {
-    const auto it = lookup.find(key);
-    if (it == lookup.end())
+    const auto slot = find(key, hash(key));
+    if (slot == NO_SLOT)
       return;
 
-    lookup.erase(it);
+    const auto node = slots[slot];
+    erase(slot);
+    unlink(node);
+    release(node);
+    --count;
   }
 
   /// @brief Returns the current number of entries in the cache.
   /// @return The number of cached entries.
-  uint32_t size() const { return lookup.size(); }
+  uint32_t size() const { return count; }
 
  private:
   uint32_t capacity;
@@ -115,11 +180,18 @@ class LRU {
     uint32_t next;
   };
 
+  // Control byte of a free table slot; full slots hold 7 hash bits (0..127)
+  static constexpr int8_t EMPTY = INT8_MIN;
+  static constexpr size_t GROUP = detail::ControlGroup::WIDTH;
+
   std::vector<Node> store;
-  uint32_t front = NIL;    ///< MRU at front
-  uint32_t back = NIL;     ///< LRU at back
-  uint32_t free_front = 0; ///< First free node
-  std::unordered_map<K, uint32_t> lookup;
+  uint32_t front = NIL;        ///< MRU at front
+  uint32_t back = NIL;         ///< LRU at back
+  uint32_t free_front = 0;     ///< First free node
+  uint32_t count = 0;          ///< Nodes in use
+  size_t mask;                 ///< Table slots - 1 (a power of two, at least 2 * capacity)
+  std::vector<int8_t> ctrl;    ///< Control bytes; the first GROUP - 1 repeat at the end
+  std::vector<uint32_t> slots; ///< Node index of each full table slot
 
   // Moves node to the front (MRU position). Unlinks from current position,
   // updates back if it was the tail. No-op if already the front.
@@ -156,17 +228,100 @@ class LRU {
   // Sentinel: no-node. prev == NIL → head, next == NIL → tail, front/back == NIL → empty.
   static constexpr uint32_t NIL = UINT32_MAX;
 
-  // Removes the LRU (tail) node, erases it from the map, and returns it to the free list.
+  // Sentinel: key not in the table.
+  static constexpr size_t NO_SLOT = SIZE_MAX;
+
+  // Removes the LRU (tail) node, erases it from the table, and returns it to the free list.
   void evict() {
-    lookup.erase(store[back].key);
     auto node = back;
-    back = store[node].prev;
-    store[back].next = NIL;        // Last element next is now NIL
-    store[node].prev = NIL;        // move node to head of free nodes
-    store[node].next = free_front; // move node to head of free nodes
+    erase(find(store[node].key, hash(store[node].key)));
+    unlink(node);
+    release(node);
+    --count;
+  }
+
+  // Detaches a node from the recency list.
+  void unlink(uint32_t node) {
+    auto prev = store[node].prev;
+    auto next = store[node].next;
+    if (prev != NIL) {
+      store[prev].next = next;
+    } else {
+      front = next;
+    }
+    if (next != NIL) {
+      store[next].prev = prev;
+    } else {
+      back = prev;
+    }
+  }
+
+  // Pushes a detached node onto the free list.
+  void release(uint32_t node) {
+    store[node].prev = NIL;
+    store[node].next = free_front;
     free_front = node;
   }
 
+  // Spreads the hash over all 64 bits; std::hash is the identity for integers.
+  static uint64_t hash(const K& key) {
+    uint64_t h = static_cast<uint64_t>(Hash{}(key)) * 0x9e3779b97f4a7c15;
+    return h ^ (h >> 32);
+  }
+
+  // 7 bits of the hash kept in the control byte, to skip most key comparisons
+  static int8_t tag(uint64_t h) { return static_cast<int8_t>(h & 0x7f); }
+
+  // First slot of the key's probe sequence
+  size_t home(uint64_t h) const { return (h >> 7) & mask; }
+
+  void set_ctrl(size_t slot, int8_t value) {
+    ctrl[slot] = value;
+    if (slot < GROUP - 1)
+      ctrl[mask + 1 + slot] = value; // Mirror, so a group read near the end needs no wrap
+  }
+
+  // Returns the table slot holding key, or NO_SLOT.
+  size_t find(const K& key, uint64_t h) const {
+    for (size_t pos = home(h);; pos = (pos + GROUP) & mask) {
+      const detail::ControlGroup group(&ctrl[pos]);
+      for (auto match = group.match(tag(h)); match != 0; match &= match - 1) {
+        const size_t slot = (pos + static_cast<size_t>(std::countr_zero(match))) & mask;
+        if (store[slots[slot]].key == key)
+          return slot;
+      }
+      if (group.match(EMPTY) != 0)
+        return NO_SLOT; // A probe run ends at the first empty slot
+    }
+  }
+
+  // Places a node in the first empty slot of its probe sequence. The table never fills.
+  void insert(uint64_t h, uint32_t node) {
+    for (size_t pos = home(h);; pos = (pos + GROUP) & mask) {
+      const auto empty = detail::ControlGroup(&ctrl[pos]).match(EMPTY);
+      if (empty != 0) {
+        const size_t slot = (pos + static_cast<size_t>(std::countr_zero(empty))) & mask;
+        set_ctrl(slot, tag(h));
+        slots[slot] = node;
+        return;
+      }
+    }
+  }
+
+  // Backward-shift deletion: pulls later entries of the probe run into the hole while
+  // their home is not between the hole and them, so no tombstone is left behind.
+  void erase(size_t hole) {
+    for (size_t next = (hole + 1) & mask; ctrl[next] != EMPTY; next = (next + 1) & mask) {
+      const size_t ideal = home(hash(store[slots[next]].key));
+      if (((next - ideal) & mask) >= ((next - hole) & mask)) {
+        set_ctrl(hole, ctrl[next]);
+        slots[hole] = slots[next];
+        hole = next;
+      }
+    }
+    set_ctrl(hole, EMPTY);
+  }
+
   // Pops a node from the free list, fills it, and links it at the front.
   uint32_t emplace_front(K key, const V& value) {
     auto node = free_front;
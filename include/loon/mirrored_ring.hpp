@@ -0,0 +1,230 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file mirrored_ring.hpp
+/// @brief Ring buffer whose storage is mapped twice so every region is contiguous (Linux).
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <sys/mman.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace loon {
+
+#ifdef __linux__
+
+/// @brief A ring buffer whose pages are mapped twice, back to back, so that it never wraps.
+///
+/// The storage is a memfd mapped at two adjacent addresses. Slot capacity() + i aliases
+/// slot i, so the readable region and the free region are each a single contiguous span
+/// no matter where they start, and a bulk copy of up to capacity() elements is one memcpy.
+/// Decoders can parse records that straddle the end of the storage without stitching two
+/// fragments together.
+///
+/// The capacity is chosen at construction and rounded up so the storage is a whole number
+/// of pages. T must be trivially copyable, since every element is visible at two addresses.
+/// Like RingBuffer, it is not thread-safe, and push() rejects new elements when full.
+///
+/// @tparam T The element type to store (trivially copyable).
+/// @par Example
+/// @code
+/// loon::MirroredRingBuffer<std::byte> feed(1 << 16);
+/// auto free = feed.writable_span();
+/// feed.produce(receive(sock, free));         // bytes written into the span
+/// feed.consume(parse_records(feed.readable_span()));  // contiguous across the wrap point
+/// @endcode
+template <typename T>
+class MirroredRingBuffer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "MirroredRingBuffer requires trivially copyable T");
+
+ public:
+  /// @brief Maps an empty buffer.
+  /// @param capacity The minimum number of elements, rounded up to fill whole pages.
+  /// @throws std::system_error if the memfd cannot be created or mapped.
+  explicit MirroredRingBuffer(size_t capacity) {
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t granule = std::lcm(page, sizeof(T));
+    bytes_ = (std::max<size_t>(capacity, 1) * sizeof(T) + granule - 1) / granule * granule;
+    capacity_ = bytes_ / sizeof(T);
+    data_ = map(bytes_);
+  }
+
+  /// @brief Unmaps both views of the storage.
+  ~MirroredRingBuffer() {
+    if (data_ != nullptr)
+      ::munmap(data_, 2 * bytes_);
+  }
+
+  MirroredRingBuffer(MirroredRingBuffer&& other) noexcept
+      : data_(std::exchange(other.data_, nullptr)),
+        bytes_(std::exchange(other.bytes_, 0)),
+        capacity_(std::exchange(other.capacity_, 0)),
+        read_(std::exchange(other.read_, 0)),
+        count_(std::exchange(other.count_, 0)) {}
+
+  MirroredRingBuffer(const MirroredRingBuffer&) = delete;
+  MirroredRingBuffer& operator=(const MirroredRingBuffer&) = delete;
+  MirroredRingBuffer& operator=(MirroredRingBuffer&&) = delete;
+
+  /// @brief Pushes a value to the back of the buffer.
+  /// @param value The value to push (copied).
+  /// @return true if the value was added, false if the buffer is full.
+  [[nodiscard]] bool push(const T& value) {
+    if (full())
+      return false;
+    data_[read_ + count_] = value;
+    ++count_;
+    return true;
+  }
+
+  /// @brief Removes and returns the front element.
+  /// @return The front element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> pop() {
+    if (empty())
+      return std::nullopt;
+    T value = data_[read_];
+    consume(1);
+    return value;
+  }
+
+  /// @brief Returns the front element without removing it.
+  /// @return The front element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> front() const {
+    if (empty())
+      return std::nullopt;
+    return data_[read_];
+  }
+
+  /// @brief Returns the back element without removing it.
+  /// @return The back element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> back() const {
+    if (empty())
+      return std::nullopt;
+    return data_[read_ + count_ - 1];
+  }
+
+  /// @brief Discards the front element without returning it.
+  /// @return true if an element was discarded, false if the buffer was empty.
+  bool discard() {
+    if (empty())
+      return false;
+    consume(1);
+    return true;
+  }
+
+  /// @brief Pushes as many values as fit with a single memcpy.
+  /// @param values The values to push (copied, in order).
+  /// @return The number of values pushed, 0 if the buffer is full.
+  [[nodiscard]] size_t push_n(std::span<const T> values) {
+    const size_t n = std::min(values.size(), capacity_ - count_);
+    if (n > 0)
+      std::memcpy(data_ + read_ + count_, values.data(), n * sizeof(T));
+    count_ += n;
+    return n;
+  }
+
+  /// @brief Pops as many values as available into the span with a single memcpy.
+  /// @param values The destination (output, filled from the front).
+  /// @return The number of values popped, 0 if the buffer is empty.
+  [[nodiscard]] size_t pop_n(std::span<T> values) {
+    const size_t n = std::min(values.size(), count_);
+    if (n > 0)
+      std::memcpy(values.data(), data_ + read_, n * sizeof(T));
+    consume(n);
+    return n;
+  }
+
+  /// @brief Returns every element as one contiguous span, oldest first.
+  ///
+  /// The span stays valid until the buffer is modified.
+  [[nodiscard]] std::span<T> readable_span() { return {data_ + read_, count_}; }
+
+  /// @brief Returns every element as one contiguous span, oldest first.
+  [[nodiscard]] std::span<const T> readable_span() const { return {data_ + read_, count_}; }
+
+  /// @brief Removes n elements from the front, e.g. after reading them via readable_span().
+  /// @param n The number of elements to remove (must be <= size()).
+  void consume(size_t n) {
+    read_ += n;
+    if (read_ >= capacity_)
+      read_ -= capacity_;
+    count_ -= n;
+  }
+
+  /// @brief Returns the free slots as one contiguous span, in push order.
+  ///
+  /// Write elements into the span, then call produce() to append them.
+  [[nodiscard]] std::span<T> writable_span() {
+    return {data_ + read_ + count_, capacity_ - count_};
+  }
+
+  /// @brief Appends n elements written through writable_span().
+  /// @param n The number of elements to append (must be <= capacity() - size()).
+  void produce(size_t n) { count_ += n; }
+
+  /// @brief Returns the number of elements the buffer can hold, after rounding to pages.
+  [[nodiscard]] size_t capacity() const { return capacity_; }
+
+  /// @brief Returns the current number of elements.
+  [[nodiscard]] size_t size() const { return count_; }
+
+  /// @brief Checks if the buffer is empty.
+  [[nodiscard]] bool empty() const { return count_ == 0; }
+
+  /// @brief Checks if the buffer is full.
+  [[nodiscard]] bool full() const { return count_ == capacity_; }
+
+ private:
+  T* data_ = nullptr; // First of the two views; data_[capacity_ + i] aliases data_[i]
+  size_t bytes_ = 0;  // Size of one view
+  size_t capacity_ = 0;
+  size_t read_ = 0; // Always < capacity_, so read_ + count_ stays inside the second view
+  size_t count_ = 0;
+
+  // Reserves 2 * bytes of address space and maps the same memfd pages into both halves.
+  static T* map(size_t bytes) {
+    const int fd = ::memfd_create("loon_ring", MFD_CLOEXEC);
+    if (fd < 0)
+      throw_errno("memfd_create");
+    void* base = MAP_FAILED;
+    try {
+      if (::ftruncate(fd, static_cast<off_t>(bytes)) != 0)
+        throw_errno("ftruncate");
+      base = ::mmap(nullptr, 2 * bytes, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (base == MAP_FAILED)
+        throw_errno("mmap");
+      auto* first = static_cast<std::byte*>(base);
+      for (auto* view : {first, first + bytes}) {
+        if (::mmap(view, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) ==
+            MAP_FAILED)
+          throw_errno("mmap");
+      }
+    } catch (...) {
+      if (base != MAP_FAILED)
+        ::munmap(base, 2 * bytes);
+      ::close(fd);
+      throw;
+    }
+    ::close(fd); // the mappings keep the pages alive
+    return static_cast<T*>(base);
+  }
+
+  [[noreturn]] static void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+};
+
+#endif // __linux__
+
+} // namespace loon
@@ -0,0 +1,150 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file mpmc.hpp
+/// @brief Bounded lock-free multi-producer multi-consumer queue.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace loon {
+
+/// @brief A bounded lock-free multi-producer multi-consumer (MPMC) queue.
+///
+/// MpmcQueue follows Dmitry Vyukov's bounded queue design. Every slot carries a sequence
+/// number that tells producers whether the slot is free for the current lap and tells
+/// consumers whether it holds a value for the current lap. Producers and consumers claim
+/// positions with a CAS on their own cache-line-padded index and then touch only the
+/// claimed slot, so producers never contend with consumers on the same index.
+///
+/// Like SpscQueue, indices are ever-increasing and the queue rejects new elements when
+/// full. Buffer access uses a mask when N is a power of two and modulo N otherwise.
+///
+/// @tparam T The element type to store.
+/// @tparam N The maximum number of elements the queue can hold (must be >= 2).
+/// @par Example
+/// @code
+/// loon::MpmcQueue<int, 1024> queue;
+/// queue.push(42);          // from any thread
+/// int value;
+/// if (queue.pop(value)) {  // from any thread
+///     // use value
+/// }
+/// @endcode
+template <typename T, size_t N>
+class MpmcQueue {
+  // With one slot a consumed slot's sequence (pos + N) equals the next enqueue position
+  static_assert(N >= 2, "MpmcQueue capacity must be at least 2");
+  static_assert(std::atomic<size_t>::is_always_lock_free, "MpmcQueue requires lock-free atomics");
+
+ public:
+  using value_type = T;
+
+  /// @brief Constructs an empty queue.
+  MpmcQueue() {
+    for (size_t i = 0; i < N; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpmcQueue(const MpmcQueue&) = delete;
+  MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+  /// @brief Pushes a value to the back of the queue.
+  /// @param value The value to push (copied).
+  /// @return true if the value was added, false if the queue is full.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] bool push(const T& value) {
+    auto write = write_idx_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[index(write)];
+      const auto sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(sequence - write);
+      if (diff == 0) {
+        // Slot is free for this lap; claim it
+        if (write_idx_.compare_exchange_weak(write, write + 1, std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(write + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // Slot still holds the previous lap's value
+      } else {
+        write = write_idx_.load(std::memory_order_relaxed); // Another producer claimed it
+      }
+    }
+  }
+
+  /// @brief Pops a value from the front of the queue.
+  /// @param value The value popped from the queue (output).
+  /// @return true if a value was popped, false if the queue is empty.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] bool pop(T& value) {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[index(read)];
+      const auto sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(sequence - (read + 1));
+      if (diff == 0) {
+        // Slot holds this lap's value; claim it
+        if (read_idx_.compare_exchange_weak(read, read + 1, std::memory_order_relaxed)) {
+          value = cell.value;
+          cell.sequence.store(read + N, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // Slot not yet written for this lap
+      } else {
+        read = read_idx_.load(std::memory_order_relaxed); // Another consumer claimed it
+      }
+    }
+  }
+
+  /// @brief Returns the maximum number of elements the queue can hold.
+  size_t capacity() const { return N; }
+
+  /// @brief Checks if the queue is empty.
+  ///
+  /// Only a snapshot when other threads are pushing or popping concurrently.
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  /// @brief Checks if the queue is full.
+  ///
+  /// Only a snapshot when other threads are pushing or popping concurrently.
+  [[nodiscard]] bool full() const { return size() >= N; }
+
+  /// @brief Returns the approximate number of elements in the queue.
+  ///
+  /// Claimed but not yet completed pushes and pops are included.
+  [[nodiscard]] size_t size() const {
+    const auto read = read_idx_.load(std::memory_order_acquire);
+    const auto write = write_idx_.load(std::memory_order_acquire);
+    return static_cast<intptr_t>(write - read) > 0 ? write - read : 0;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  Cell cells_[N];
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_idx_{0}; // Shared by producers
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_idx_{0};  // Shared by consumers
+
+  static constexpr size_t index(size_t i) {
+    if constexpr (std::has_single_bit(N)) {
+      return i & (N - 1);
+    } else {
+      return i % N;
+    }
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,126 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file mpsc.hpp
+/// @brief Bounded lock-free multi-producer single-consumer queue.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace loon {
+
+/// @brief A bounded lock-free multi-producer single-consumer (MPSC) queue.
+///
+/// MpscQueue is tuned for fan-in: many threads push, one thread pops. Producers claim
+/// positions with a CAS on a shared, cache-line-padded index and use per-slot sequence
+/// numbers (as in MpmcQueue) to detect a full queue. The consumer owns its read index
+/// outright: it never performs a CAS and hands slots back to producers through the slot
+/// sequence alone, so the pop path is one acquire load, the copy and one release store.
+///
+/// @tparam T The element type to store.
+/// @tparam N The maximum number of elements the queue can hold (must be >= 2).
+/// @par Example
+/// @code
+/// loon::MpscQueue<LogRecord, 4096> log_queue;
+/// log_queue.push(record);         // from any thread
+/// LogRecord next;
+/// if (log_queue.pop(next)) {      // writer thread only
+///     write(next);
+/// }
+/// @endcode
+template <typename T, size_t N>
+class MpscQueue {
+  // With one slot a consumed slot's sequence (pos + N) equals the next enqueue position
+  static_assert(N >= 2, "MpscQueue capacity must be at least 2");
+  static_assert(std::atomic<size_t>::is_always_lock_free, "MpscQueue requires lock-free atomics");
+
+ public:
+  using value_type = T;
+
+  /// @brief Constructs an empty queue.
+  MpscQueue() {
+    for (size_t i = 0; i < N; ++i) {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /// @brief Pushes a value to the back of the queue.
+  /// @param value The value to push (copied).
+  /// @return true if the value was added, false if the queue is full.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] bool push(const T& value) {
+    auto write = write_idx_.load(std::memory_order_relaxed);
+    for (;;) {
+      auto& cell = cells_[index(write)];
+      const auto sequence = cell.sequence.load(std::memory_order_acquire);
+      const auto diff = static_cast<intptr_t>(sequence - write);
+      if (diff == 0) {
+        // Slot is free for this lap; claim it
+        if (write_idx_.compare_exchange_weak(write, write + 1, std::memory_order_relaxed)) {
+          cell.value = value;
+          cell.sequence.store(write + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false; // Consumer has not drained the previous lap yet
+      } else {
+        write = write_idx_.load(std::memory_order_relaxed); // Another producer claimed it
+      }
+    }
+  }
+
+  /// @brief Pops a value from the front of the queue.
+  ///
+  /// Returns false while the producer that claimed the front slot is still writing it,
+  /// even if later slots are already filled, which keeps delivery in claim order.
+  /// @param value The value popped from the queue (output).
+  /// @return true if a value was popped, false if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] bool pop(T& value) {
+    auto& cell = cells_[index(read_idx_)];
+    if (cell.sequence.load(std::memory_order_acquire) != read_idx_ + 1)
+      return false;
+    value = cell.value;
+    cell.sequence.store(read_idx_ + N, std::memory_order_release);
+    ++read_idx_;
+    return true;
+  }
+
+  /// @brief Returns the maximum number of elements the queue can hold.
+  size_t capacity() const { return N; }
+
+  /// @brief Checks if the front slot holds no published value.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] bool empty() const {
+    return cells_[index(read_idx_)].sequence.load(std::memory_order_acquire) != read_idx_ + 1;
+  }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  Cell cells_[N];
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_idx_{0}; // Shared by producers
+  alignas(CACHE_LINE_SIZE) size_t read_idx_{0};               // Consumer-owned, never shared
+
+  static constexpr size_t index(size_t i) {
+    if constexpr (std::has_single_bit(N)) {
+      return i & (N - 1);
+    } else {
+      return i % N;
+    }
+  }
+};
+
+} // namespace loon
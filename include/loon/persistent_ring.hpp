@@ -0,0 +1,419 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file persistent_ring.hpp
+/// @brief RingBuffer kept in a memory-mapped file, recovered from checksummed records on open.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace loon {
+
+namespace detail {
+
+// Non-cryptographic 64-bit checksum of a journal record: one multiply-xorshift round per
+// 8-byte word, seeded with the record's sequence number so a stale record from an earlier
+// lap never validates in a later slot.
+inline uint64_t journal_checksum(uint64_t sequence, const void* data, size_t size) {
+  constexpr uint64_t MUL = 0xff51afd7ed558ccd;
+  const auto* bytes = static_cast<const std::byte*>(data);
+  uint64_t hash = 0x9e3779b97f4a7c15 ^ sequence;
+  uint64_t word;
+  for (; size >= sizeof(word); size -= sizeof(word), bytes += sizeof(word)) {
+    std::memcpy(&word, bytes, sizeof(word));
+    hash = (hash ^ word) * MUL;
+    hash ^= hash >> 29;
+  }
+  word = 0;
+  std::memcpy(&word, bytes, size);
+  hash = (hash ^ word ^ size) * MUL;
+  return hash ^ (hash >> 32);
+}
+
+} // namespace detail
+
+/// @brief A RingBuffer whose slots and read/write positions live in a memory-mapped file.
+///
+/// The file holds a versioned header with the read and write sequence numbers, followed
+/// by N records. Each record stores its sequence number, a checksum and the value. Since
+/// the mapping is shared with the page cache, every push and pop survives a crash or
+/// restart of the process as soon as it returns. Surviving a kernel crash or power loss
+/// also needs the pages on disk: flush() writes back what changed since the last flush
+/// with msync(MS_SYNC), and a flush interval makes that automatic every so many pushes
+/// and pops.
+///
+/// Opening an existing file recovers the ring. Records are validated from the header's
+/// read position until the first one whose sequence number or checksum does not match,
+/// which becomes the write position. If the record at the read position no longer
+/// validates, for instance because pushes overwrote it before the advanced read position
+/// reached the disk, recovery instead scans every slot for the newest valid record and
+/// restarts at the oldest valid one no more than N behind it. A push torn by a crash is
+/// dropped; a pop not yet written back may be delivered again.
+///
+/// Like RingBuffer, it is not thread-safe. T must be trivially copyable, since values are
+/// stored as raw bytes in the file.
+///
+/// @tparam T The element type to store (trivially copyable).
+/// @tparam N The maximum number of elements the ring can hold (must be > 0).
+/// @par Example
+/// @code
+/// loon::PersistentRingBuffer<Event, 1 << 20> history("/var/lib/app/events.ring");
+/// history.push(event);             // survives a process restart once it returns
+///
+/// // After a restart the last events are back without replaying them from upstream
+/// loon::PersistentRingBuffer<Event, 1 << 20> recovered("/var/lib/app/events.ring");
+/// auto latest = recovered.back();
+/// @endcode
+template <typename T, size_t N>
+class PersistentRingBuffer {
+  static_assert(std::is_trivially_copyable_v<T>,
+                "PersistentRingBuffer requires trivially copyable T");
+  static_assert(N > 0, "PersistentRingBuffer capacity must be greater than 0");
+
+ public:
+  using value_type = T;
+
+  /// @brief Layout version stored in the header; bumped whenever the layout changes.
+  static constexpr uint32_t VERSION = 1;
+
+  /// @brief Opens the journal at path, creating it if it does not exist.
+  /// @param path The journal file.
+  /// @param override_when_full If true, push() overwrites the oldest element when full.
+  /// @param flush_interval Call flush() after every this many pushes and pops; 0 leaves
+  ///                       write-back to the kernel until flush() is called.
+  /// @throws std::system_error if the file cannot be opened, sized or mapped.
+  /// @throws std::runtime_error if an existing file does not match PersistentRingBuffer<T, N>.
+  explicit PersistentRingBuffer(const std::string& path, bool override_when_full = false,
+                                size_t flush_interval = 0)
+      : override_(override_when_full), flush_interval_(flush_interval) {
+    const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0)
+      throw_errno("open");
+    try {
+      struct stat st {};
+      if (::fstat(fd, &st) != 0)
+        throw_errno("fstat");
+      const auto existing = read_data_offset(fd, static_cast<size_t>(st.st_size));
+      const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+      data_offset_ = existing.value_or(std::max(page, sizeof(Header)));
+      bytes_ = data_offset_ + N * sizeof(Record);
+      if (static_cast<size_t>(st.st_size) < bytes_) {
+        if (existing)
+          throw std::runtime_error("PersistentRingBuffer: file is smaller than its layout");
+        if (::ftruncate(fd, static_cast<off_t>(bytes_)) != 0)
+          throw_errno("ftruncate");
+      }
+
+      void* memory = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (memory == MAP_FAILED)
+        throw_errno("mmap");
+      base_ = static_cast<std::byte*>(memory);
+    } catch (...) {
+      ::close(fd);
+      throw;
+    }
+    ::close(fd); // the mapping keeps the file open
+
+    try {
+      if (header().magic == MAGIC) {
+        validate();
+        recover();
+      } else {
+        initialize();
+      }
+    } catch (...) {
+      ::munmap(base_, bytes_);
+      throw;
+    }
+  }
+
+  /// @brief Flushes pending changes if a flush interval is set, then unmaps the file.
+  ~PersistentRingBuffer() {
+    if (base_ == nullptr)
+      return;
+    if (flush_interval_ != 0 && unflushed_ != 0)
+      (void)sync_ranges();
+    ::munmap(base_, bytes_);
+  }
+
+  PersistentRingBuffer(PersistentRingBuffer&& other) noexcept
+      : base_(std::exchange(other.base_, nullptr)),
+        bytes_(std::exchange(other.bytes_, 0)),
+        data_offset_(other.data_offset_),
+        override_(other.override_),
+        flush_interval_(other.flush_interval_),
+        unflushed_(other.unflushed_),
+        flushed_(other.flushed_),
+        recovered_(other.recovered_) {}
+
+  PersistentRingBuffer(const PersistentRingBuffer&) = delete;
+  PersistentRingBuffer& operator=(const PersistentRingBuffer&) = delete;
+  PersistentRingBuffer& operator=(PersistentRingBuffer&&) = delete;
+
+  /// @brief Pushes a value to the back of the ring.
+  /// @param value The value to push (copied).
+  /// @return true if the value was added, false if the ring is full and override disabled.
+  /// @throws std::system_error if an automatic flush fails.
+  [[nodiscard]] bool push(const T& value) {
+    Header& h = header();
+    if (h.write - h.read == N) {
+      if (!override_)
+        return false;
+      ++h.read;
+    }
+    Record& record = slot(h.write);
+    std::memcpy(&record.value, &value, sizeof(T));
+    record.sequence = h.write;
+    record.checksum = detail::journal_checksum(h.write, &record.value, sizeof(T));
+    ++h.write; // Published last; recovery re-derives it from the records anyway
+    count_change();
+    return true;
+  }
+
+  /// @brief Removes and returns the front element.
+  /// @return The front element, or std::nullopt if empty.
+  /// @throws std::system_error if an automatic flush fails.
+  [[nodiscard]] std::optional<T> pop() {
+    if (empty())
+      return std::nullopt;
+    const T value = load(header().read);
+    ++header().read;
+    count_change();
+    return value;
+  }
+
+  /// @brief Returns the front element without removing it.
+  /// @return The front element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> front() const {
+    if (empty())
+      return std::nullopt;
+    return load(header().read);
+  }
+
+  /// @brief Returns the back element without removing it.
+  /// @return The back element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> back() const {
+    if (empty())
+      return std::nullopt;
+    return load(header().write - 1);
+  }
+
+  /// @brief Discards the front element without returning it.
+  /// @return true if an element was discarded, false if the ring was empty.
+  /// @throws std::system_error if an automatic flush fails.
+  bool discard() {
+    if (empty())
+      return false;
+    ++header().read;
+    count_change();
+    return true;
+  }
+
+  /// @brief Writes every change since the last flush to disk with msync(MS_SYNC).
+  ///
+  /// Only the header page and the pages of records pushed since the last flush are
+  /// synced. Called automatically every flush_interval pushes and pops.
+  /// @throws std::system_error if msync fails.
+  void flush() {
+    if (!sync_ranges())
+      throw_errno("msync");
+  }
+
+  /// @brief Returns the number of elements found valid when the file was opened.
+  [[nodiscard]] size_t recovered() const { return recovered_; }
+
+  /// @brief Returns the current number of elements.
+  [[nodiscard]] size_t size() const { return header().write - header().read; }
+
+  /// @brief Returns the maximum number of elements the ring can hold.
+  [[nodiscard]] size_t capacity() const { return N; }
+
+  /// @brief Checks if the ring is empty.
+  [[nodiscard]] bool empty() const { return size() == 0; }
+
+  /// @brief Checks if the ring is full.
+  [[nodiscard]] bool full() const { return size() == N; }
+
+  /// @brief Checks if override mode is enabled.
+  [[nodiscard]] bool overrides() const { return override_; }
+
+ private:
+  static constexpr uint64_t MAGIC = 0x6c6f6f6e4a524e4c; // "loonJRNL"
+
+  struct Header {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t record_size;
+    uint64_t capacity;
+    uint64_t data_offset; // Records start on a page boundary
+    uint64_t read;        // Sequence number of the front element
+    uint64_t write;       // Sequence number of the next push
+  };
+
+  struct Record {
+    uint64_t sequence;
+    uint64_t checksum;
+    T value;
+  };
+
+  std::byte* base_ = nullptr;
+  size_t bytes_ = 0;
+  size_t data_offset_ = 0;
+  bool override_;
+  size_t flush_interval_;
+  size_t unflushed_ = 0; // Pushes and pops since the last flush
+  uint64_t flushed_ = 0; // Write position at the last flush
+  size_t recovered_ = 0;
+
+  Header& header() { return *reinterpret_cast<Header*>(base_); }
+  const Header& header() const { return *reinterpret_cast<const Header*>(base_); }
+
+  static constexpr size_t index(uint64_t sequence) {
+    if constexpr (std::has_single_bit(N)) {
+      return static_cast<size_t>(sequence & (N - 1));
+    } else {
+      return static_cast<size_t>(sequence % N);
+    }
+  }
+
+  Record& slot(uint64_t sequence) {
+    return reinterpret_cast<Record*>(base_ + data_offset_)[index(sequence)];
+  }
+  const Record& slot(uint64_t sequence) const {
+    return reinterpret_cast<const Record*>(base_ + data_offset_)[index(sequence)];
+  }
+
+  // Copies through raw bytes, so T needs no default constructor.
+  T load(uint64_t sequence) const {
+    std::array<std::byte, sizeof(T)> bytes;
+    std::memcpy(bytes.data(), &slot(sequence).value, sizeof(T));
+    return std::bit_cast<T>(bytes);
+  }
+
+  bool valid(uint64_t sequence) const {
+    const Record& record = slot(sequence);
+    return record.sequence == sequence &&
+           record.checksum == detail::journal_checksum(sequence, &record.value, sizeof(T));
+  }
+
+  void count_change() {
+    if (flush_interval_ != 0 && ++unflushed_ >= flush_interval_)
+      flush();
+  }
+
+  // Syncs the header page and the record pages written since the last flush.
+  bool sync_ranges() {
+    const uint64_t write = header().write;
+    bool ok = sync(0, sizeof(Header));
+    const uint64_t pending = std::min<uint64_t>(write - flushed_, N);
+    if (pending != 0) {
+      const size_t first = index(write - pending);
+      const size_t tail = std::min<size_t>(pending, N - first);
+      ok &= sync(data_offset_ + first * sizeof(Record), tail * sizeof(Record));
+      ok &= sync(data_offset_, (pending - tail) * sizeof(Record));
+    }
+    flushed_ = write;
+    unflushed_ = 0;
+    return ok;
+  }
+
+  // msyncs the pages covering [offset, offset + size) of the mapping.
+  bool sync(size_t offset, size_t size) {
+    if (size == 0)
+      return true;
+    const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+    const size_t begin = offset / page * page;
+    return ::msync(base_ + begin, offset + size - begin, MS_SYNC) == 0;
+  }
+
+  void initialize() {
+    Header& h = header();
+    h.version = VERSION;
+    h.record_size = sizeof(Record);
+    h.capacity = N;
+    h.data_offset = data_offset_;
+    h.read = h.write = 0;
+    h.magic = MAGIC; // Written last: a file without it is initialized from scratch
+  }
+
+  void validate() const {
+    const Header& h = header();
+    if (h.version != VERSION)
+      throw std::runtime_error("PersistentRingBuffer: layout version mismatch");
+    if (h.record_size != sizeof(Record) || h.capacity != N)
+      throw std::runtime_error("PersistentRingBuffer: element type or capacity mismatch");
+  }
+
+  // Rebuilds the read and write positions from the records. The saved read position is a
+  // lower bound: records before it were popped, but it may lag behind pushes that
+  // overwrote its record, in which case the ring restarts at the newest record minus N.
+  void recover() {
+    Header& h = header();
+    uint64_t read = h.read;
+    if (!valid(read)) {
+      if (const auto newest = newest_valid(read)) {
+        read = std::max(read, *newest + 1 >= N ? *newest + 1 - N : 0);
+        while (!valid(read)) {
+          ++read; // Stops at newest at the latest
+        }
+      }
+    }
+    uint64_t write = read;
+    while (write - read < N && valid(write)) {
+      ++write;
+    }
+    h.read = read;
+    h.write = write;
+    flushed_ = write;
+    recovered_ = static_cast<size_t>(write - read);
+  }
+
+  // Returns the highest valid sequence number not below from, scanning every slot.
+  std::optional<uint64_t> newest_valid(uint64_t from) const {
+    std::optional<uint64_t> newest;
+    for (size_t i = 0; i < N; ++i) {
+      const uint64_t sequence = reinterpret_cast<const Record*>(base_ + data_offset_)[i].sequence;
+      if (index(sequence) == i && sequence >= from && valid(sequence) &&
+          (!newest || sequence > *newest))
+        newest = sequence;
+    }
+    return newest;
+  }
+
+  // Returns the record offset of an initialized journal, or std::nullopt for a new file.
+  static std::optional<size_t> read_data_offset(int fd, size_t file_size) {
+    Header h{};
+    if (file_size < sizeof(h))
+      return std::nullopt; // New file
+    if (::pread(fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h)))
+      throw_errno("pread");
+    if (h.magic == 0)
+      return std::nullopt; // Sized but never initialized
+    if (h.magic != MAGIC)
+      throw std::runtime_error("PersistentRingBuffer: file is not a loon journal");
+    return h.data_offset;
+  }
+
+  [[noreturn]] static void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+};
+
+} // namespace loon
@@ -6,9 +6,25 @@
 /// @file ring_buffer.hpp
 /// @brief Fixed-size ring buffer (circular queue) implementation.
 
+#include <loon/instrument.hpp>
+
+#include <algorithm>
 #include <array>
+#include <bit>
+#include <compare>
+#include <concepts>
 #include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace loon {
 
@@ -18,8 +34,17 @@ namespace loon {
 /// fixed capacity. When full, it can either reject new elements or override
 /// the oldest element depending on configuration.
 ///
+/// The backing array is uninitialized storage: elements are constructed in place when
+/// pushed and destroyed when popped, discarded or overwritten, so T may be move-only or
+/// lack a default constructor, and an empty buffer constructs nothing.
+///
+/// The Instrument policy is notified on every push and pop. The default
+/// NoInstrumentation compiles away; DwellInstrumentation records how long elements wait
+/// and the highest occupancy seen.
+///
 /// @tparam T The element type to store.
 /// @tparam N The fixed capacity of the buffer (must be > 0).
+/// @tparam Instrument The instrumentation policy (NoInstrumentation or DwellInstrumentation).
 ///
 /// @par Example
 /// @code
@@ -28,9 +53,16 @@ namespace loon {
 /// buffer.push(43);
 /// auto val = buffer.pop();  // returns 42
 /// @endcode
-template <typename T, size_t N>
+template <typename T, size_t N, typename Instrument = NoInstrumentation>
 class RingBuffer {
+  template <bool Const>
+  class basic_iterator;
+
  public:
+  using value_type = T;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
   /// @brief Constructs an empty RingBuffer with default behavior (reject when full).
   RingBuffer() = default;
 
@@ -39,33 +71,96 @@ class RingBuffer {
   ///                           If false, push() returns false when full.
   explicit RingBuffer(bool override_when_full) : override(override_when_full) {}
 
+  /// @brief Copies the elements and the override mode of another buffer.
+  RingBuffer(const RingBuffer& other)
+    requires std::copy_constructible<T>
+      : override(other.override) {
+    copy_from(other);
+  }
+
+  /// @brief Moves the elements of another buffer, leaving it empty.
+  RingBuffer(RingBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    requires std::move_constructible<T>
+      : override(other.override) {
+    move_from(other);
+  }
+
+  RingBuffer& operator=(const RingBuffer& other)
+    requires std::copy_constructible<T>
+  {
+    if (this != &other) {
+      clear();
+      override = other.override;
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  RingBuffer& operator=(RingBuffer&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+    requires std::move_constructible<T>
+  {
+    if (this != &other) {
+      clear();
+      override = other.override;
+      move_from(other);
+    }
+    return *this;
+  }
+
+  ~RingBuffer()
+    requires std::is_trivially_destructible_v<T>
+  = default;
+
+  /// @brief Destroys the remaining elements.
+  ~RingBuffer() { clear(); }
+
   /// @brief Pushes a value to the back of the buffer.
   /// @param value The value to push (copied).
   /// @return true if the value was added, false if buffer is full and override is disabled.
-  [[nodiscard]] bool push(const T& value) {
+  [[nodiscard]] bool push(const T& value) { return emplace(value); }
+
+  /// @brief Pushes a value to the back of the buffer.
+  /// @param value The value to push (moved from only if it is added).
+  /// @return true if the value was added, false if buffer is full and override is disabled.
+  [[nodiscard]] bool push(T&& value) { return emplace(std::move(value)); }
+
+  /// @brief Constructs a value in place at the back of the buffer.
+  /// @param args The arguments forwarded to T's constructor.
+  /// @return true if the value was added, false if buffer is full and override is disabled.
+  template <typename... Args>
+  [[nodiscard]] bool emplace(Args&&... args) {
     if (full()) {
       if (!override) {
         return false;
       }
-      // advance read pointer to discard oldest
-      read = (read + 1) % N;
+      // args may alias the oldest element (e.g. push(rb[0])), so build the value first,
+      // then destroy the oldest element and advance past it
+      T value(std::forward<Args>(args)...);
+      std::destroy_at(&element(read));
+      read = next(read);
+      --count;
+      std::construct_at(address(write), std::move(value));
     } else {
-      ++count;
+      std::construct_at(address(write), std::forward<Args>(args)...);
     }
-    buffer[write] = value;
-    write = (write + 1) % N;
+    ++count;
+    instrument.on_push(write);
+    write = next(write);
 
     return true;
   }
 
-  /// @brief Removes and returns the front element.
+  /// @brief Removes and returns the front element, moving it out of its slot.
   /// @return The front element, or std::nullopt if empty.
   [[nodiscard]] std::optional<T> pop() {
     if (empty()) {
       return std::nullopt;
     }
-    T value = buffer[read];
-    read = (read + 1) % N;
+    T& slot = element(read);
+    std::optional<T> value(std::move(slot));
+    std::destroy_at(&slot);
+    instrument.on_pop(read, count);
+    read = next(read);
     --count;
     return value;
   }
@@ -76,7 +171,7 @@ class RingBuffer {
     if (empty()) {
       return std::nullopt;
     }
-    return buffer[read];
+    return element(read);
   }
 
   /// @brief Returns the back element without removing it.
@@ -85,7 +180,7 @@ class RingBuffer {
     if (empty()) {
       return std::nullopt;
     }
-    return buffer[(write - 1 + N) % N];
+    return element(write == 0 ? N - 1 : write - 1);
   }
 
   /// @brief Discards the front element without returning it.
@@ -94,11 +189,156 @@ class RingBuffer {
     if (empty()) {
       return false;
     }
-    read = (read + 1) % N;
+    std::destroy_at(&element(read));
+    instrument.on_pop(read, count);
+    read = next(read);
     --count;
     return true;
   }
 
+  /// @brief Returns the elements as at most two contiguous spans, oldest first.
+  ///
+  /// The second span is empty unless the elements wrap around the end of the storage.
+  /// The spans stay valid until the buffer is modified.
+  /// @return The spans in FIFO order; both are empty if the buffer is empty.
+  [[nodiscard]] std::array<std::span<T>, 2> readable_spans() {
+    const size_t first = std::min(count, N - read);
+    return {std::span<T>(address(read), first), std::span<T>(address(0), count - first)};
+  }
+
+  /// @brief Returns the elements as at most two contiguous spans, oldest first.
+  [[nodiscard]] std::array<std::span<const T>, 2> readable_spans() const {
+    const size_t first = std::min(count, N - read);
+    return {std::span<const T>(address(read), first),
+            std::span<const T>(address(0), count - first)};
+  }
+
+  /// @brief Removes n elements from the front, e.g. after reading them via readable_spans().
+  /// @param n The number of elements to remove (must be <= size()).
+  void consume(size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<T> || Instrument::enabled) {
+      for (size_t i = 0; i < n; ++i) {
+        const size_t slot = advance(read, i);
+        std::destroy_at(&element(slot));
+        instrument.on_pop(slot, count - i);
+      }
+    }
+    read = advance(read, n);
+    count -= n;
+  }
+
+  /// @brief Returns the free slots as at most two contiguous spans, in push order.
+  ///
+  /// Write elements into the spans, then call produce() to append them. Only available
+  /// for trivially copyable T, whose slots need no construction. In override mode the
+  /// spans still cover only the free slots.
+  /// @return The spans in push order; both are empty if the buffer is full.
+  [[nodiscard]] std::array<std::span<T>, 2> writable_spans()
+    requires std::is_trivially_copyable_v<T>
+  {
+    const size_t free = N - count;
+    const size_t first = std::min(free, N - write);
+    return {std::span<T>(address(write), first), std::span<T>(address(0), free - first)};
+  }
+
+  /// @brief Appends n elements written through writable_spans().
+  /// @param n The number of elements to append (must be <= capacity() - size()).
+  void produce(size_t n)
+    requires std::is_trivially_copyable_v<T>
+  {
+    record_push(write, n);
+    write = advance(write, n);
+    count += n;
+  }
+
+  /// @brief Pushes values to the back as at most two contiguous copies.
+  ///
+  /// Trivially copyable values are copied with memcpy. In override mode every value is
+  /// accepted: the oldest elements are dropped to make room, and if there are more values
+  /// than the capacity only the last N are kept. values may be a span of this buffer; it is
+  /// then copied aside before the oldest elements are dropped.
+  /// @param values The values to push (copied, in order).
+  /// @return The number of values accepted, less than values.size() only if the buffer
+  ///         filled up and override is disabled.
+  [[nodiscard]] size_t push_n(std::span<const T> values) {
+    const size_t accepted = override ? values.size() : std::min(values.size(), N - count);
+    if (override) {
+      if (values.size() > N) {
+        values = values.last(N);
+      }
+      const size_t free = N - count;
+      if (values.size() > free) {
+        // values may point into this buffer (e.g. readable_spans()), whose oldest
+        // elements are about to be dropped and overwritten, so copy them out first
+        if (overlaps(values)) {
+          const std::vector<T> staged(values.begin(), values.end());
+          static_cast<void>(push_n(std::span<const T>(staged)));
+          return accepted;
+        }
+        drop(values.size() - free);
+      }
+    } else {
+      values = values.first(accepted);
+    }
+
+    const size_t first = std::min(values.size(), N - write);
+    append(values.first(first));
+    append(values.subspan(first));
+    return accepted;
+  }
+
+  /// @brief Pops elements from the front into a span as at most two contiguous moves.
+  /// @param values The destination (output, move-assigned from the front).
+  /// @return The number of elements popped, 0 if the buffer is empty.
+  [[nodiscard]] size_t pop_n(std::span<T> values) {
+    const size_t n = std::min(values.size(), count);
+    const size_t first = std::min(n, N - read);
+    if constexpr (Instrument::enabled) {
+      for (size_t i = 0; i < n; ++i) {
+        instrument.on_pop(advance(read, i), count - i);
+      }
+    }
+    move_elements(address(read), first, values.data());
+    move_elements(address(0), n - first, values.data() + first);
+    read = advance(read, n);
+    count -= n;
+    return n;
+  }
+
+  /// @brief Returns the element at a logical position, 0 being the oldest.
+  /// @param i The position (must be < size()).
+  [[nodiscard]] T& operator[](size_t i) { return element(advance(read, i)); }
+
+  /// @brief Returns the element at a logical position, 0 being the oldest.
+  [[nodiscard]] const T& operator[](size_t i) const { return element(advance(read, i)); }
+
+  /// @brief Returns the element at a logical position, checking the bounds.
+  /// @param i The position, 0 being the oldest.
+  /// @throws std::out_of_range if i >= size().
+  [[nodiscard]] T& at(size_t i) {
+    check_index(i);
+    return (*this)[i];
+  }
+
+  /// @brief Returns the element at a logical position, checking the bounds.
+  /// @throws std::out_of_range if i >= size().
+  [[nodiscard]] const T& at(size_t i) const {
+    check_index(i);
+    return (*this)[i];
+  }
+
+  /// @brief Returns a random-access iterator to the oldest element.
+  ///
+  /// Iterators walk the elements from oldest to newest and are invalidated by any push,
+  /// pop or discard. Together with end() they make the buffer a std::ranges
+  /// random_access_range, so standard algorithms run over the live window in place.
+  [[nodiscard]] iterator begin() { return iterator(this, 0); }
+  [[nodiscard]] iterator end() { return iterator(this, count); }
+  [[nodiscard]] const_iterator begin() const { return const_iterator(this, 0); }
+  [[nodiscard]] const_iterator end() const { return const_iterator(this, count); }
+  [[nodiscard]] const_iterator cbegin() const { return begin(); }
+  [[nodiscard]] const_iterator cend() const { return end(); }
+
   /// @brief Returns the maximum capacity of the buffer.
   /// @return The compile-time capacity N.
   [[nodiscard]] size_t capacity() const { return N; }
@@ -119,12 +359,223 @@ class RingBuffer {
   /// @return The number of elements in the buffer.
   [[nodiscard]] size_t size() const { return count; }
 
+  /// @brief Returns the instrumentation policy, e.g. for snapshot() and reset().
+  Instrument& instrumentation() { return instrument; }
+
+  /// @brief Returns the instrumentation policy.
+  const Instrument& instrumentation() const { return instrument; }
+
  private:
-  std::array<T, N> buffer;
+  alignas(T) std::byte buffer[N * sizeof(T)];
   size_t write = 0;
   size_t read = 0;
   size_t count = 0;
   bool override = false;
+  [[no_unique_address]] Instrument instrument{N};
+
+  // Advances an index by one slot. Power-of-two N wraps with a mask; other sizes compare
+  // and reset instead of paying for a division.
+  static constexpr size_t next(size_t i) {
+    if constexpr (std::has_single_bit(N)) {
+      return (i + 1) & (N - 1);
+    } else {
+      return i + 1 == N ? 0 : i + 1;
+    }
+  }
+
+  // Advances an index by n <= N slots.
+  static constexpr size_t advance(size_t i, size_t n) {
+    if constexpr (std::has_single_bit(N)) {
+      return (i + n) & (N - 1);
+    } else {
+      return i + n >= N ? i + n - N : i + n;
+    }
+  }
+
+  void check_index(size_t i) const {
+    if (i >= count)
+      throw std::out_of_range("RingBuffer::at: index out of range");
+  }
+
+  T* address(size_t i) { return reinterpret_cast<T*>(buffer) + i; }
+  const T* address(size_t i) const { return reinterpret_cast<const T*>(buffer) + i; }
+  T& element(size_t i) { return *std::launder(address(i)); }
+  const T& element(size_t i) const { return *std::launder(address(i)); }
+
+  // Destroys the n oldest elements to make room in override mode.
+  void drop(size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = 0; i < n; ++i) {
+        std::destroy_at(&element(advance(read, i)));
+      }
+    }
+    read = advance(read, n);
+    count -= n;
+  }
+
+  // Checks whether values lies in this buffer's storage.
+  bool overlaps(std::span<const T> values) const {
+    const std::less<const T*> before;
+    return !values.empty() && before(values.data(), address(N)) &&
+           before(address(0), values.data() + values.size());
+  }
+
+  // Copies values into the contiguous free slots starting at write.
+  void append(std::span<const T> values) {
+    construct_elements(values.data(), values.size(), address(write));
+    record_push(write, values.size());
+    write = advance(write, values.size());
+    count += values.size();
+  }
+
+  // Notifies the instrumentation policy about a batch; empty when it is disabled.
+  void record_push(size_t slot, size_t n) {
+    if constexpr (Instrument::enabled) {
+      for (size_t i = 0; i < n; ++i) {
+        instrument.on_push(advance(slot, i));
+      }
+    }
+  }
+
+  // Copy-constructs n contiguous elements into free slots, using memcpy when T allows it.
+  static void construct_elements(const T* src, size_t n, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (n > 0)
+        std::memcpy(dst, src, n * sizeof(T));
+    } else {
+      std::uninitialized_copy_n(src, n, dst);
+    }
+  }
+
+  // Moves n contiguous elements out of their slots and destroys them, using memcpy when T
+  // allows it.
+  static void move_elements(T* src, size_t n, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (n > 0)
+        std::memcpy(dst, src, n * sizeof(T));
+    } else {
+      for (size_t i = 0; i < n; ++i) {
+        dst[i] = std::move(*std::launder(src + i));
+        std::destroy_at(std::launder(src + i));
+      }
+    }
+  }
+
+  // Destroys every element and resets the indices.
+  void clear() {
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      for (size_t i = read; count > 0; i = next(i), --count) {
+        std::destroy_at(&element(i));
+      }
+    }
+    write = read = count = 0;
+  }
+
+  // Constructs copies of other's elements in the same slots; this buffer must be empty.
+  void copy_from(const RingBuffer& other) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memcpy(buffer, other.buffer, sizeof(buffer));
+    } else {
+      for (size_t i = other.read, n = 0; n < other.count; i = next(i), ++n) {
+        std::construct_at(address(i), other.element(i));
+      }
+    }
+    write = other.write;
+    read = other.read;
+    count = other.count;
+  }
+
+  // Moves other's elements into the same slots and empties other; this buffer must be empty.
+  void move_from(RingBuffer& other) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      std::memcpy(buffer, other.buffer, sizeof(buffer));
+    } else {
+      for (size_t i = other.read, n = 0; n < other.count; i = next(i), ++n) {
+        std::construct_at(address(i), std::move(other.element(i)));
+      }
+    }
+    write = other.write;
+    read = other.read;
+    count = other.count;
+    other.clear();
+  }
+};
+
+// Random-access iterator holding a logical position; dereferencing maps it to a slot.
+template <typename T, size_t N, typename Instrument>
+template <bool Const>
+class RingBuffer<T, N, Instrument>::basic_iterator {
+  using Buffer = std::conditional_t<Const, const RingBuffer, RingBuffer>;
+
+ public:
+  using iterator_category = std::random_access_iterator_tag;
+  using iterator_concept = std::random_access_iterator_tag;
+  using value_type = T;
+  using difference_type = std::ptrdiff_t;
+  using pointer = std::conditional_t<Const, const T*, T*>;
+  using reference = std::conditional_t<Const, const T&, T&>;
+
+  basic_iterator() = default;
+
+  // Mutable iterators convert to const ones. A template, so it is never the copy constructor.
+  template <bool OtherConst>
+    requires(Const && !OtherConst)
+  basic_iterator(const basic_iterator<OtherConst>& other)
+      : buffer_(other.buffer_), index_(other.index_) {}
+
+  reference operator*() const { return (*buffer_)[index_]; }
+  pointer operator->() const { return &(*buffer_)[index_]; }
+  reference operator[](difference_type n) const { return (*buffer_)[index_ + n]; }
+
+  basic_iterator& operator++() {
+    ++index_;
+    return *this;
+  }
+  basic_iterator operator++(int) {
+    auto copy = *this;
+    ++index_;
+    return copy;
+  }
+  basic_iterator& operator--() {
+    --index_;
+    return *this;
+  }
+  basic_iterator operator--(int) {
+    auto copy = *this;
+    --index_;
+    return copy;
+  }
+  basic_iterator& operator+=(difference_type n) {
+    index_ += n;
+    return *this;
+  }
+  basic_iterator& operator-=(difference_type n) {
+    index_ -= n;
+    return *this;
+  }
+
+  friend basic_iterator operator+(basic_iterator it, difference_type n) { return it += n; }
+  friend basic_iterator operator+(difference_type n, basic_iterator it) { return it += n; }
+  friend basic_iterator operator-(basic_iterator it, difference_type n) { return it -= n; }
+  friend difference_type operator-(const basic_iterator& a, const basic_iterator& b) {
+    return static_cast<difference_type>(a.index_ - b.index_);
+  }
+  friend bool operator==(const basic_iterator& a, const basic_iterator& b) {
+    return a.index_ == b.index_;
+  }
+  friend std::strong_ordering operator<=>(const basic_iterator& a, const basic_iterator& b) {
+    return a.index_ <=> b.index_;
+  }
+
+ private:
+  friend class RingBuffer;
+  template <bool>
+  friend class basic_iterator;
+
+  basic_iterator(Buffer* buffer, size_t index) : buffer_(buffer), index_(index) {}
+
+  Buffer* buffer_ = nullptr;
+  size_t index_ = 0;
 };
 
 } // namespace loon
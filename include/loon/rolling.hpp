@@ -0,0 +1,228 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file rolling.hpp
+/// @brief Incremental rolling sum, mean, variance, min and max over a RingBuffer window.
+
+#include <loon/ring_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace loon {
+
+namespace detail {
+
+// Fixed-capacity monotonic deque of (sequence, value) entries. Values are kept ordered
+// under Compare from front to back, so the front is the window's extreme. A new value
+// evicts every entry at the back that it dominates; each entry is pushed and popped once,
+// which makes updates amortized O(1).
+template <typename T, size_t N, typename Compare>
+class MonotonicDeque {
+ public:
+  void push(uint64_t seq, T value) {
+    while (size_ > 0 && !Compare{}(entries_[slot(size_ - 1)].value, value)) {
+      --size_;
+    }
+    entries_[slot(size_)] = {seq, value};
+    ++size_;
+  }
+
+  // Drops the front entry if it is the element leaving the window.
+  void expire(uint64_t seq) {
+    if (size_ > 0 && entries_[head_].seq == seq) {
+      head_ = head_ + 1 == N ? 0 : head_ + 1;
+      --size_;
+    }
+  }
+
+  T front() const { return entries_[head_].value; }
+
+  void clear() { head_ = size_ = 0; }
+
+ private:
+  struct Entry {
+    uint64_t seq;
+    T value;
+  };
+
+  std::array<Entry, N> entries_;
+  size_t head_ = 0;
+  size_t size_ = 0;
+
+  size_t slot(size_t i) const { return head_ + i >= N ? head_ + i - N : head_ + i; }
+};
+
+// Sums a contiguous span with four independent accumulators, so the loop has no serial
+// dependency and the compiler can keep the partial sums in one vector register.
+template <typename T, typename Op>
+double sum_lanes(std::span<const T> values, Op op) {
+  std::array<double, 4> lanes{};
+  size_t i = 0;
+  for (; i + 4 <= values.size(); i += 4) {
+    for (size_t lane = 0; lane < 4; ++lane) {
+      lanes[lane] += op(static_cast<double>(values[i + lane]));
+    }
+  }
+  for (; i < values.size(); ++i) {
+    lanes[0] += op(static_cast<double>(values[i]));
+  }
+  return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+}
+
+} // namespace detail
+
+/// @brief Rolling statistics over the last N values, each updated in O(1) per push.
+///
+/// Values live in an override-mode RingBuffer. Each push() updates the running sum and
+/// Welford's mean and sum of squared deviations by adding the new value and removing
+/// the one that fell out of the window. Min and max come from two monotonic deques,
+/// so they are amortized O(1) as well. Reading a statistic never rescans the window.
+///
+/// Sums and variance are kept in double. Removing values from running sums accumulates
+/// rounding error over very long streams; recompute() rebuilds them exactly from the
+/// window in two passes over contiguous spans. Pass a recompute interval to the
+/// constructor to do this automatically every so many pushes.
+///
+/// @tparam T The arithmetic value type.
+/// @tparam N The window length (must be > 0).
+/// @par Example
+/// @code
+/// loon::RollingWindow<double, 512> mid;          // last 512 mid prices
+/// mid.push(price);
+/// auto vol = mid.stddev();
+/// auto range = mid.max() - mid.min();
+///
+/// // VWAP over the last 512 trades: two windows, one division
+/// loon::RollingWindow<double, 512> notional, volume;
+/// notional.push(price * qty);
+/// volume.push(qty);
+/// auto vwap = notional.sum() / volume.sum();
+/// @endcode
+template <typename T, size_t N>
+class RollingWindow {
+  static_assert(std::is_arithmetic_v<T>, "RollingWindow requires an arithmetic value type");
+  static_assert(N > 0, "RollingWindow length must be greater than 0");
+
+ public:
+  /// @brief Constructs an empty window.
+  /// @param recompute_interval Rebuild sum and variance from scratch every this many
+  ///                           pushes to bound floating-point drift; 0 never does.
+  explicit RollingWindow(size_t recompute_interval = 0)
+      : recompute_interval_(recompute_interval) {}
+
+  /// @brief Appends a value, evicting the oldest one once the window is full.
+  void push(T value) {
+    const auto x = static_cast<double>(value);
+    if (window_.full()) {
+      const auto evicted = static_cast<double>(window_[0]);
+      const uint64_t evicted_seq = pushed_ - N;
+      min_.expire(evicted_seq);
+      max_.expire(evicted_seq);
+      // Welford update that replaces evicted with x, keeping n fixed
+      const double old_mean = mean_;
+      mean_ += (x - evicted) / static_cast<double>(N);
+      m2_ += (x - evicted) * (x - mean_ + evicted - old_mean);
+      sum_ += x - evicted;
+    } else {
+      const double delta = x - mean_;
+      mean_ += delta / static_cast<double>(window_.size() + 1);
+      m2_ += delta * (x - mean_);
+      sum_ += x;
+    }
+    (void)window_.push(value);
+    min_.push(pushed_, value);
+    max_.push(pushed_, value);
+    ++pushed_;
+
+    if (recompute_interval_ != 0 && ++since_recompute_ == recompute_interval_) {
+      recompute();
+    }
+  }
+
+  /// @brief Rebuilds the sum, mean and variance exactly from the values in the window.
+  ///
+  /// O(N), in two passes over at most two contiguous spans.
+  void recompute() {
+    since_recompute_ = 0;
+    const auto [first, second] = std::as_const(window_).readable_spans();
+    const auto value = std::identity{};
+    sum_ = detail::sum_lanes(first, value) + detail::sum_lanes(second, value);
+    mean_ = window_.empty() ? 0.0 : sum_ / static_cast<double>(window_.size());
+    const auto deviation = [mean = mean_](double x) { return (x - mean) * (x - mean); };
+    m2_ = detail::sum_lanes(first, deviation) + detail::sum_lanes(second, deviation);
+  }
+
+  /// @brief Removes every value.
+  void clear() {
+    while (window_.discard()) {
+    }
+    min_.clear();
+    max_.clear();
+    sum_ = mean_ = m2_ = 0.0;
+    since_recompute_ = 0;
+  }
+
+  /// @brief Returns the sum of the values in the window.
+  [[nodiscard]] double sum() const { return sum_; }
+
+  /// @brief Returns the mean of the values in the window, 0 if empty.
+  [[nodiscard]] double mean() const { return mean_; }
+
+  /// @brief Returns the population variance of the window, 0 if empty.
+  [[nodiscard]] double variance() const {
+    return window_.empty() ? 0.0 : std::max(m2_, 0.0) / static_cast<double>(window_.size());
+  }
+
+  /// @brief Returns the sample variance (divided by size() - 1), 0 with fewer than two values.
+  [[nodiscard]] double sample_variance() const {
+    return window_.size() < 2 ? 0.0
+                              : std::max(m2_, 0.0) / static_cast<double>(window_.size() - 1);
+  }
+
+  /// @brief Returns the population standard deviation of the window.
+  [[nodiscard]] double stddev() const { return std::sqrt(variance()); }
+
+  /// @brief Returns the smallest value in the window (must not be empty).
+  [[nodiscard]] T min() const { return min_.front(); }
+
+  /// @brief Returns the largest value in the window (must not be empty).
+  [[nodiscard]] T max() const { return max_.front(); }
+
+  /// @brief Returns the values, oldest first.
+  [[nodiscard]] const RingBuffer<T, N>& values() const { return window_; }
+
+  /// @brief Returns the number of values in the window.
+  [[nodiscard]] size_t size() const { return window_.size(); }
+
+  /// @brief Returns the window length N.
+  [[nodiscard]] size_t capacity() const { return N; }
+
+  /// @brief Checks if the window holds no values.
+  [[nodiscard]] bool empty() const { return window_.empty(); }
+
+  /// @brief Checks if the window holds N values.
+  [[nodiscard]] bool full() const { return window_.full(); }
+
+ private:
+  RingBuffer<T, N> window_{true};
+  detail::MonotonicDeque<T, N, std::less<T>> min_;
+  detail::MonotonicDeque<T, N, std::greater<T>> max_;
+  uint64_t pushed_ = 0; // Sequence number of the next value
+  double sum_ = 0.0;
+  double mean_ = 0.0;
+  double m2_ = 0.0; // Sum of squared deviations from the mean
+  size_t recompute_interval_;
+  size_t since_recompute_ = 0;
+};
+
+} // namespace loon
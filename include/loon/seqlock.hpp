@@ -0,0 +1,105 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file seqlock.hpp
+/// @brief Seqlock-protected "latest value" slot for conflating updates.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+
+namespace loon {
+
+/// @brief A single slot holding the latest value, protected by a sequence lock.
+///
+/// Unlike SpscQueue, a Seqlock keeps only the newest value: each store() overwrites the
+/// previous one, so a slow reader skips stale updates instead of draining them (e.g. a
+/// top-of-book snapshot). The writer never waits. It makes the sequence odd, copies the
+/// value and makes the sequence even again. Readers copy the value between two reads of
+/// the sequence and retry if a store overlapped the copy, so any number of readers can
+/// poll the slot without writing to shared memory.
+///
+/// The sequence and the value share a cache-line-aligned block, so a reader touches as
+/// few lines as possible. T must be trivially copyable, since readers may copy a value
+/// that is being overwritten and then discard it. ThreadSanitizer flags such an
+/// overlapping copy as a data race; that report is expected, since the sequence check
+/// discards the copy.
+///
+/// @tparam T The value type (trivially copyable).
+/// @par Example
+/// @code
+/// loon::Seqlock<Quote> top_of_book;
+/// top_of_book.store(quote);              // writer thread
+///
+/// Quote latest = top_of_book.load();     // any reader thread
+/// @endcode
+template <typename T>
+class Seqlock {
+  static_assert(std::is_trivially_copyable_v<T>, "Seqlock requires trivially copyable T");
+  static_assert(std::atomic<size_t>::is_always_lock_free, "Seqlock requires lock-free atomics");
+
+ public:
+  using value_type = T;
+
+  /// @brief Constructs the slot holding a value-initialized T.
+  Seqlock() = default;
+
+  /// @brief Constructs the slot holding the given value.
+  /// @param value The initial value (copied).
+  explicit Seqlock(const T& value) : value_(value) {}
+
+  Seqlock(const Seqlock&) = delete;
+  Seqlock& operator=(const Seqlock&) = delete;
+
+  /// @brief Replaces the current value. Wait-free.
+  /// @param value The new value (copied).
+  /// This method is safe to call from the writer thread only.
+  void store(const T& value) {
+    const auto sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release); // Odd sequence before the copy
+    std::memcpy(&value_, &value, sizeof(T));
+    sequence_.store(sequence + 2, std::memory_order_release);
+  }
+
+  /// @brief Tries once to read the current value.
+  /// @param value The current value (output, copied). Left unspecified on failure.
+  /// @return true if a consistent value was read, false if a store overlapped the read.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] bool try_load(T& value) const {
+    const auto before = sequence_.load(std::memory_order_acquire);
+    if (before & 1)
+      return false;
+    std::memcpy(&value, &value_, sizeof(T));
+    std::atomic_thread_fence(std::memory_order_acquire); // Copy before the second read
+    return sequence_.load(std::memory_order_relaxed) == before;
+  }
+
+  /// @brief Reads the current value, retrying while stores overlap the read.
+  ///
+  /// Lock-free: a reader only retries when the writer made progress.
+  /// @return A consistent copy of the latest stored value.
+  /// This method is safe to call from any thread.
+  [[nodiscard]] T load() const {
+    T value;
+    while (!try_load(value)) {
+    }
+    return value;
+  }
+
+  /// @brief Returns the number of completed stores.
+  ///
+  /// Readers can compare it with a previously seen count to skip unchanged values.
+  [[nodiscard]] size_t version() const { return sequence_.load(std::memory_order_acquire) / 2; }
+
+ private:
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> sequence_{0}; // Odd while a store is running
+  T value_{};
+};
+
+} // namespace loon
@@ -0,0 +1,156 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file sharded_lru.hpp
+/// @brief Thread-safe LRU cache split into independently locked shards.
+
+#include <loon/lru.hpp>
+#include <loon/spsc.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace loon {
+
+/// @brief A thread-safe LRU cache made of independently locked LRU shards.
+///
+/// Each key hashes to one of a power-of-two number of shards. A shard holds an LRU and
+/// its own lock and sits on its own cache line, so threads working on different shards
+/// neither contend for a lock nor false-share one. Every operation locks exactly one
+/// shard; size() locks each shard in turn.
+///
+/// Recency is tracked per shard: when a shard is full, put() evicts that shard's least
+/// recently used entry, which is not necessarily the oldest entry of the whole cache.
+/// With a reasonable hash, keys spread evenly and the result is close to a global LRU.
+///
+/// get() returns a copy of the value, since a reference would outlive the shard lock.
+///
+/// @tparam K Key type (must be hashable with Hash and equality comparable)
+/// @tparam V Value type (copied out by get())
+/// @tparam Lock Per-shard lock: std::mutex, or SpinLock for short critical sections
+/// @tparam Hash Hash function for K
+///
+/// @code
+/// loon::ShardedLRU<std::string, int> cache(100'000, 64);  // 64 shards
+/// cache.put("key", 42);                                   // from any thread
+/// if (auto val = cache.get("key")) {
+///     std::cout << *val << std::endl;
+/// }
+/// @endcode
+template <typename K, typename V, typename Lock = std::mutex, typename Hash = std::hash<K>>
+class ShardedLRU {
+ public:
+  /// @brief Constructs a cache holding about capacity entries split over shards shards.
+  ///
+  /// The shard count is rounded up to a power of two, and down to at most capacity so
+  /// no shard is empty. Each shard holds capacity / shards entries, rounded up.
+  ///
+  /// @param capacity Total number of entries the cache can hold (must be > 0).
+  /// @param shards Number of shards (must be > 0).
+  explicit ShardedLRU(uint32_t capacity, uint32_t shards = 16)
+      : shard_mask_(std::min(std::bit_ceil(shards), std::bit_floor(capacity)) - 1),
+        shard_capacity_((capacity + shard_mask_) / (shard_mask_ + 1)),
+        shards_(std::allocator<Shard>().allocate(shard_mask_ + 1)) {
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+      std::construct_at(shards_ + i, shard_capacity_);
+    }
+  }
+
+  ~ShardedLRU() {
+    std::destroy_n(shards_, shard_mask_ + 1);
+    std::allocator<Shard>().deallocate(shards_, shard_mask_ + 1);
+  }
+
+  ShardedLRU(const ShardedLRU&) = delete;
+  ShardedLRU& operator=(const ShardedLRU&) = delete;
+
+  /// @brief Retrieves a copy of a value and marks the key as most recently used.
+  /// @param key The key to look up.
+  /// @return A copy of the value if found, std::nullopt otherwise.
+  std::optional<V> get(const K& key) {
+    auto& shard = shard_for(key);
+    std::lock_guard guard(shard.lock);
+    if (auto value = shard.cache.get(key))
+      return value->get();
+    return std::nullopt;
+  }
+
+  /// @brief Inserts or updates a key-value pair.
+  ///
+  /// If the key's shard is full, its least recently used entry is evicted.
+  ///
+  /// @param key The key to insert or update.
+  /// @param value The value to associate with the key.
+  void put(const K& key, const V& value) {
+    auto& shard = shard_for(key);
+    std::lock_guard guard(shard.lock);
+    shard.cache.put(key, value);
+  }
+
+  /// @brief Checks if a key exists, without affecting its recency.
+  /// @param key The key to check.
+  /// @return true if the key exists, false otherwise.
+  [[nodiscard]] bool exists(const K& key) {
+    auto& shard = shard_for(key);
+    std::lock_guard guard(shard.lock);
+    return shard.cache.exists(key);
+  }
+
+  /// @brief Removes a key-value pair. Has no effect if the key does not exist.
+  /// @param key The key to remove.
+  void remove(const K& key) {
+    auto& shard = shard_for(key);
+    std::lock_guard guard(shard.lock);
+    shard.cache.remove(key);
+  }
+
+  /// @brief Returns the number of entries, summed over all shards.
+  ///
+  /// Shards are counted one at a time, so under concurrent updates the result is a
+  /// snapshot of each shard rather than of the whole cache.
+  ///
+  /// @return The number of cached entries.
+  [[nodiscard]] size_t size() {
+    size_t total = 0;
+    for (size_t i = 0; i <= shard_mask_; ++i) {
+      std::lock_guard guard(shards_[i].lock);
+      total += shards_[i].cache.size();
+    }
+    return total;
+  }
+
+  /// @brief Returns the total capacity: shard_count() * the capacity of one shard.
+  [[nodiscard]] size_t capacity() const { return shard_count() * shard_capacity_; }
+
+  /// @brief Returns the number of shards (a power of two).
+  [[nodiscard]] size_t shard_count() const { return shard_mask_ + 1; }
+
+ private:
+  struct alignas(CACHE_LINE_SIZE) Shard {
+    explicit Shard(uint32_t capacity) : cache(capacity) {}
+
+    Lock lock;
+    LRU<K, V, Hash> cache;
+  };
+
+  size_t shard_mask_;       ///< Shards - 1 (a power of two)
+  uint32_t shard_capacity_; ///< Entries per shard
+  Shard* shards_;
+
+  // Picks the shard from a different mix of the hash than LRU's index uses, so the keys
+  // of one shard still spread over its whole table.
+  Shard& shard_for(const K& key) {
+    const uint64_t h = static_cast<uint64_t>(Hash{}(key)) * 0xff51afd7ed558ccd;
+    return shards_[(h >> 32) & shard_mask_];
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,231 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file shm_spsc.hpp
+/// @brief SpscQueue placed in shared memory for interprocess communication.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <fcntl.h>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <system_error>
+#include <type_traits>
+#include <unistd.h>
+#include <utility>
+
+namespace loon {
+
+/// @brief A SpscQueue living in a shared memory mapping, usable across processes.
+///
+/// The mapping holds a versioned header followed by a regular SpscQueue<T, N>, so the
+/// producer and consumer indices keep their cache-line-separated layout. One process
+/// creates the region (named with shm_open, or anonymous with memfd_create), the other
+/// attaches to it by name or by inherited file descriptor. Attaching validates the
+/// header against the attaching process's view of T and N before the queue is used.
+///
+/// The producer and consumer must each live in exactly one process. T must be trivially
+/// copyable, since the element bytes are shared between address spaces.
+///
+/// @tparam T The element type to store (trivially copyable).
+/// @tparam N The maximum number of elements the queue can hold (must be > 0).
+/// @par Example
+/// @code
+/// // Feed handler
+/// auto feed = loon::ShmSpscQueue<Tick, 4096>::create("/ticks");
+/// feed.queue().push(tick);
+///
+/// // Strategy process
+/// auto ticks = loon::ShmSpscQueue<Tick, 4096>::attach("/ticks");
+/// Tick tick;
+/// if (ticks.queue().pop(tick)) {
+///     // use tick
+/// }
+/// @endcode
+template <typename T, size_t N>
+class ShmSpscQueue {
+  static_assert(std::is_trivially_copyable_v<T>, "ShmSpscQueue requires trivially copyable T");
+  static_assert(N != DYNAMIC_CAPACITY, "ShmSpscQueue requires a compile-time capacity");
+  static_assert(std::atomic<size_t>::is_always_lock_free,
+                "ShmSpscQueue requires address-free lock-free atomics");
+
+ public:
+  /// @brief Layout version stored in the header; bumped whenever the layout changes.
+  ///
+  /// - 1: Header followed by SpscQueue<T, N>.
+  /// - 2: SpscQueue gained its Instrument policy member.
+  /// - 3: SpscQueue slots became uninitialized storage.
+  static constexpr uint32_t VERSION = 3;
+
+  /// @brief Creates a named shared memory queue with shm_open.
+  ///
+  /// The name is unlinked when the creating object is destroyed; processes that already
+  /// attached keep their mapping.
+  /// @param name The POSIX shared memory name (e.g. "/ticks").
+  /// @throws std::system_error if the region already exists or cannot be created.
+  static ShmSpscQueue create(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fd < 0)
+      throw_errno("shm_open");
+    try {
+      ShmSpscQueue shm(fd, true);
+      shm.name_ = name;
+      return shm;
+    } catch (...) {
+      ::shm_unlink(name.c_str());
+      throw;
+    }
+  }
+
+  /// @brief Attaches to a named queue created by another process.
+  /// @param name The POSIX shared memory name passed to create().
+  /// @throws std::system_error if the region cannot be opened or mapped.
+  /// @throws std::runtime_error if the header does not match this ShmSpscQueue<T, N>.
+  static ShmSpscQueue attach(const std::string& name) {
+    const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0)
+      throw_errno("shm_open");
+    return ShmSpscQueue(fd, false);
+  }
+
+#ifdef __linux__
+  /// @brief Creates an anonymous shared memory queue with memfd_create.
+  ///
+  /// Share it with a forked child (which can keep using this object) or pass fd() to
+  /// another process over a Unix socket and attach() there.
+  /// @throws std::system_error if the region cannot be created.
+  static ShmSpscQueue create_anonymous() {
+    const int fd = ::memfd_create("loon_spsc", MFD_CLOEXEC);
+    if (fd < 0)
+      throw_errno("memfd_create");
+    return ShmSpscQueue(fd, true);
+  }
+#endif
+
+  /// @brief Attaches to a queue through a file descriptor received from its creator.
+  /// @param fd A descriptor of the region; it is duplicated, the caller keeps ownership.
+  /// @throws std::system_error if the region cannot be mapped.
+  /// @throws std::runtime_error if the header does not match this ShmSpscQueue<T, N>.
+  static ShmSpscQueue attach(int fd) {
+    const int dup_fd = ::dup(fd);
+    if (dup_fd < 0)
+      throw_errno("dup");
+    return ShmSpscQueue(dup_fd, false);
+  }
+
+  /// @brief Unmaps the region, and unlinks its name if this object created it.
+  ~ShmSpscQueue() {
+    if (region_ != nullptr)
+      ::munmap(region_, sizeof(Region));
+    if (fd_ >= 0)
+      ::close(fd_);
+    if (!name_.empty())
+      ::shm_unlink(name_.c_str());
+  }
+
+  ShmSpscQueue(ShmSpscQueue&& other) noexcept
+      : region_(std::exchange(other.region_, nullptr)),
+        fd_(std::exchange(other.fd_, -1)),
+        name_(std::move(other.name_)) {
+    other.name_.clear();
+  }
+
+  ShmSpscQueue(const ShmSpscQueue&) = delete;
+  ShmSpscQueue& operator=(const ShmSpscQueue&) = delete;
+  ShmSpscQueue& operator=(ShmSpscQueue&&) = delete;
+
+  /// @brief Returns the shared queue.
+  SpscQueue<T, N>& queue() { return region_->queue; }
+
+  /// @brief Returns the descriptor of the shared memory region.
+  int fd() const { return fd_; }
+
+ private:
+  static constexpr uint64_t MAGIC = 0x6c6f6f6e53505343; // "loonSPSC"
+
+  struct Header {
+    std::atomic<uint64_t> magic; // Published last, after the queue is constructed
+    uint32_t version;
+    uint32_t element_size;
+    uint64_t element_align;
+    uint64_t capacity;
+    uint64_t queue_size;
+  };
+
+  struct Region {
+    alignas(CACHE_LINE_SIZE) Header header;
+    alignas(CACHE_LINE_SIZE) SpscQueue<T, N> queue;
+  };
+
+  Region* region_ = nullptr;
+  int fd_ = -1;
+  std::string name_; // Set when this object owns the shm_open name
+
+  ShmSpscQueue(int fd, bool creator) : fd_(fd) {
+    try {
+      if (creator) {
+        if (::ftruncate(fd_, sizeof(Region)) != 0)
+          throw_errno("ftruncate");
+      } else {
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0)
+          throw_errno("fstat");
+        if (static_cast<size_t>(st.st_size) < sizeof(Region))
+          throw std::runtime_error("ShmSpscQueue: region is smaller than the expected layout");
+      }
+
+      void* memory = ::mmap(nullptr, sizeof(Region), PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+      if (memory == MAP_FAILED)
+        throw_errno("mmap");
+      region_ = static_cast<Region*>(memory);
+
+      if (creator) {
+        initialize();
+      } else {
+        validate();
+      }
+    } catch (...) {
+      if (region_ != nullptr)
+        ::munmap(region_, sizeof(Region));
+      ::close(fd_);
+      throw;
+    }
+  }
+
+  void initialize() {
+    new (&region_->queue) SpscQueue<T, N>();
+    auto& header = region_->header;
+    header.version = VERSION;
+    header.element_size = sizeof(T);
+    header.element_align = alignof(T);
+    header.capacity = N;
+    header.queue_size = sizeof(SpscQueue<T, N>);
+    header.magic.store(MAGIC, std::memory_order_release);
+  }
+
+  void validate() const {
+    const auto& header = region_->header;
+    if (header.magic.load(std::memory_order_acquire) != MAGIC)
+      throw std::runtime_error("ShmSpscQueue: region is not an initialized loon queue");
+    if (header.version != VERSION)
+      throw std::runtime_error("ShmSpscQueue: layout version mismatch");
+    if (header.element_size != sizeof(T) || header.element_align != alignof(T) ||
+        header.capacity != N || header.queue_size != sizeof(SpscQueue<T, N>))
+      throw std::runtime_error("ShmSpscQueue: element type or capacity mismatch");
+  }
+
+  [[noreturn]] static void throw_errno(const char* what) {
+    throw std::system_error(errno, std::generic_category(), what);
+  }
+};
+
+} // namespace loon
@@ -3,9 +3,24 @@
 
 #pragma once
 
+#include <loon/instrument.hpp>
+
+#include <algorithm>
 #include <atomic>
+#include <bit>
 #include <cstddef>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
 #include <new>
+#include <optional>
+#include <span>
+#include <type_traits>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
 
 #ifndef CACHE_LINE_SIZE
 #if defined(__cpp_lib_hardware_interference_size)
@@ -17,6 +32,123 @@
 
 namespace loon {
 
+/// @brief Capacity value selecting a SpscQueue whose capacity is chosen at construction.
+inline constexpr size_t DYNAMIC_CAPACITY = std::dynamic_extent;
+
+/// @brief Backing memory for runtime-capacity queues.
+///
+/// Huge pages are only mapped on Linux; elsewhere every mode uses the heap.
+enum class PageMode {
+  Normal,      ///< Cache-line aligned heap allocation.
+  Transparent, ///< Anonymous mapping advised to use transparent huge pages.
+  Huge,        ///< Explicit MAP_HUGETLB pages; falls back to Transparent if none are reserved.
+};
+
+namespace detail {
+
+// Inline slot storage for compile-time capacities. Slots are raw bytes: the queue
+// constructs elements when they are pushed and destroys them when they are popped, so T
+// needs no default constructor and an empty queue constructs nothing. Power-of-two N is
+// indexed with a mask; other sizes fall back to modulo.
+template <typename T, size_t N>
+struct SpscStorage {
+  static constexpr size_t capacity() { return N; }
+
+  static constexpr size_t index(size_t i) {
+    if constexpr (std::has_single_bit(N)) {
+      return i & (N - 1);
+    } else {
+      return i % N;
+    }
+  }
+
+  T* address(size_t i) { return data() + index(i); }
+  T& slot(size_t i) { return *std::launder(address(i)); }
+  T* data() { return reinterpret_cast<T*>(slots); }
+
+  alignas(T) std::byte slots[N * sizeof(T)];
+};
+
+// Heap or mmap slot storage for runtime capacities, rounded up to a power of two so every
+// access is a mask. Like the inline storage, slots are left unconstructed.
+template <typename T>
+class SpscStorage<T, DYNAMIC_CAPACITY> {
+ public:
+  SpscStorage(size_t capacity, PageMode pages)
+      : mask_(std::bit_ceil(std::max<size_t>(capacity, 1)) - 1) {
+    const size_t bytes = (mask_ + 1) * sizeof(T);
+#ifdef __linux__
+    if (pages != PageMode::Normal) {
+      slots_ = map(bytes, pages);
+      return;
+    }
+#else
+    (void)pages;
+#endif
+    slots_ = static_cast<T*>(::operator new(bytes, std::align_val_t{CACHE_LINE_SIZE}));
+  }
+
+  ~SpscStorage() {
+#ifdef __linux__
+    if (mapped_bytes_ != 0) {
+      ::munmap(slots_, mapped_bytes_);
+      return;
+    }
+#endif
+    ::operator delete(slots_, std::align_val_t{CACHE_LINE_SIZE});
+  }
+
+  SpscStorage(const SpscStorage&) = delete;
+  SpscStorage& operator=(const SpscStorage&) = delete;
+
+  size_t capacity() const { return mask_ + 1; }
+  size_t index(size_t i) const { return i & mask_; }
+  T* address(size_t i) { return slots_ + index(i); }
+  T& slot(size_t i) { return *std::launder(address(i)); }
+  T* data() { return slots_; }
+
+ private:
+  T* slots_ = nullptr;
+  size_t mask_;
+  size_t mapped_bytes_ = 0; // 0 when allocated with operator new
+
+#ifdef __linux__
+  static constexpr size_t HUGE_PAGE_SIZE = size_t{2} << 20;
+  static constexpr size_t PAGE_TOUCH_STRIDE = 4096;
+
+  // Maps anonymous memory, rounded up to the huge page size. Throws std::bad_alloc if the
+  // kernel refuses both the requested mode and the transparent fallback.
+  T* map(size_t bytes, PageMode pages) {
+    mapped_bytes_ = (bytes + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+    void* memory = MAP_FAILED;
+#ifdef MAP_HUGETLB
+    if (pages == PageMode::Huge) {
+      memory = ::mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+    if (memory == MAP_FAILED) {
+      memory = ::mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                      -1, 0);
+      if (memory == MAP_FAILED)
+        throw std::bad_alloc();
+#ifdef MADV_HUGEPAGE
+      ::madvise(memory, mapped_bytes_, MADV_HUGEPAGE); // advisory, ignore failure
+#endif
+    }
+    // Nothing is constructed in the slots any more, so fault the pages in now rather than
+    // on the producer's first lap
+    auto* touch = static_cast<volatile std::byte*>(memory);
+    for (size_t offset = 0; offset < bytes; offset += PAGE_TOUCH_STRIDE) {
+      touch[offset] = std::byte{0};
+    }
+    return static_cast<T*>(memory);
+  }
+#endif
+};
+
+} // namespace detail
+
 /// @brief A lock-free single-producer single-consumer (SPSC) queue with fixed capacity.
 ///
 /// SpscQueue provides O(1) push and pop operations without locks, suitable for
@@ -24,10 +156,25 @@ namespace loon {
 /// capacity is fixed at compile time and the queue will reject new elements when full.
 ///
 /// Indices are ever-increasing (never explicitly wrapped), relying on well-defined
-/// unsigned integer overflow. Buffer access uses modulo N.
+/// unsigned integer overflow. Buffer access uses a mask when N is a power of two and
+/// modulo N otherwise.
+///
+/// Slots are uninitialized storage: elements are constructed in place when pushed and
+/// destroyed when popped, so T may be move-only or lack a default constructor, and
+/// constructing a queue constructs no elements. Elements still queued when the queue is
+/// destroyed are destroyed with it.
+///
+/// With N == DYNAMIC_CAPACITY the capacity is chosen at construction instead, rounded up
+/// to a power of two, and the slots live in cache-line aligned heap memory or huge pages.
+///
+/// The Instrument policy is notified whenever a slot is published or released. The
+/// default NoInstrumentation compiles away; DwellInstrumentation records how long
+/// elements wait and the highest occupancy seen.
 ///
 /// @tparam T The element type to store.
-/// @tparam N The maximum number of elements the queue can hold (must be > 0).
+/// @tparam N The maximum number of elements the queue can hold (must be > 0), or
+///           DYNAMIC_CAPACITY.
+/// @tparam Instrument The instrumentation policy (NoInstrumentation or DwellInstrumentation).
 /// @par Example
 /// @code
 /// loon::SpscQueue<int, 3> queue;
@@ -36,31 +183,79 @@ namespace loon {
 /// if (queue.pop(value)) {
 ///     // use value
 /// }
+///
+/// loon::SpscQueue<int, loon::DYNAMIC_CAPACITY> sized(config.depth, loon::PageMode::Huge);
 /// @endcode
-template <typename T, size_t N>
+template <typename T, size_t N, typename Instrument = NoInstrumentation>
 class SpscQueue {
   static_assert(N > 0, "SpscQueue capacity must be greater than 0");
   static_assert(std::atomic<size_t>::is_always_lock_free, "SpscQueue requires lock-free atomics");
 
  public:
+  using value_type = T;
+
+  /// @brief Constructs an empty queue with compile-time capacity N.
+  SpscQueue()
+    requires(N != DYNAMIC_CAPACITY)
+  = default;
+
+  /// @brief Constructs an empty queue with a runtime capacity.
+  /// @param capacity The minimum number of elements, rounded up to a power of two.
+  /// @param pages The backing memory for the slots.
+  /// @throws std::bad_alloc if the slots cannot be allocated.
+  explicit SpscQueue(size_t capacity, PageMode pages = PageMode::Normal)
+    requires(N == DYNAMIC_CAPACITY)
+      : data_(capacity, pages) {}
+
+  SpscQueue(const SpscQueue&) = delete;
+  SpscQueue& operator=(const SpscQueue&) = delete;
+
+  ~SpscQueue()
+    requires std::is_trivially_destructible_v<T>
+  = default;
+
+  /// @brief Destroys the elements still in the queue, and any reserved but uncommitted slot.
+  ~SpscQueue() {
+    const auto write = write_idx_.load(std::memory_order_relaxed);
+    for (auto read = read_idx_.load(std::memory_order_relaxed); read != write; ++read) {
+      std::destroy_at(&data_.slot(read));
+    }
+    if (reserved_)
+      std::destroy_at(&data_.slot(write));
+  }
+
   /// @brief Pushes a value to the back of the queue.
   /// @param value The value to push (copied).
   /// @return true if the value was added, false if the queue is full.
   /// This method is safe to call from the producer thread only.
-  [[nodiscard]] bool push(const T& value) {
+  [[nodiscard]] bool push(const T& value) { return emplace(value); }
+
+  /// @brief Pushes a value to the back of the queue.
+  /// @param value The value to push (moved from only if the queue has room).
+  /// @return true if the value was added, false if the queue is full.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] bool push(T&& value) { return emplace(std::move(value)); }
+
+  /// @brief Constructs a value in place at the back of the queue.
+  /// @param args The arguments forwarded to T's constructor.
+  /// @return true if the value was added, false if the queue is full (nothing is constructed).
+  /// This method is safe to call from the producer thread only.
+  template <typename... Args>
+  [[nodiscard]] bool emplace(Args&&... args) {
     auto write = write_idx_.load(std::memory_order_relaxed);
-    if (write - read_idx_cache_ == N) {
+    if (write - read_idx_cache_ == data_.capacity()) {
       read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
-      if (write - read_idx_cache_ == N)
+      if (write - read_idx_cache_ == data_.capacity())
         return false;
     }
-    data_[write % N] = value;
+    std::construct_at(data_.address(write), std::forward<Args>(args)...);
+    instrument_.on_push(data_.index(write));
     write_idx_.store(write + 1, std::memory_order_release);
     return true;
   }
 
   /// @brief Pops a value from the front of the queue.
-  /// @param value The value popped from the queue (output).
+  /// @param value The value popped from the queue (output, move-assigned).
   /// @return true if a value was popped, false if the queue is empty.
   /// This method is safe to call from the consumer thread only.
   [[nodiscard]] bool pop(T& value) {
@@ -70,13 +265,157 @@ class SpscQueue {
       if (write_idx_cache_ == read)
         return false;
     }
-    value = data_[read % N];
+    T& slot = data_.slot(read);
+    value = std::move(slot);
+    std::destroy_at(&slot);
+    instrument_.on_pop(data_.index(read), write_idx_cache_ - read);
     read_idx_.store(read + 1, std::memory_order_release);
     return true;
   }
 
+  /// @brief Pops a value from the front of the queue, moving it out of its slot.
+  /// @return The front value, or std::nullopt if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] std::optional<T> pop() {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    if (write_idx_cache_ == read) {
+      write_idx_cache_ = write_idx_.load(std::memory_order_acquire);
+      if (write_idx_cache_ == read)
+        return std::nullopt;
+    }
+    T& slot = data_.slot(read);
+    std::optional<T> value(std::move(slot));
+    std::destroy_at(&slot);
+    instrument_.on_pop(data_.index(read), write_idx_cache_ - read);
+    read_idx_.store(read + 1, std::memory_order_release);
+    return value;
+  }
+
+  /// @brief Reserves the next free slot so the producer can build a value in place.
+  ///
+  /// The slot is default-initialized on the first call and is not visible to the consumer
+  /// until commit() is called. Calling try_reserve() again before commit() returns the same
+  /// slot without constructing it again. Requires a default-constructible T; use emplace()
+  /// otherwise.
+  /// @return A reference to the slot, or std::nullopt if the queue is full.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] std::optional<std::reference_wrapper<T>> try_reserve() {
+    auto write = write_idx_.load(std::memory_order_relaxed);
+    if (!reserved_) {
+      if (write - read_idx_cache_ == data_.capacity()) {
+        read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+        if (write - read_idx_cache_ == data_.capacity())
+          return std::nullopt;
+      }
+      ::new (static_cast<void*>(data_.address(write))) T;
+      reserved_ = true;
+    }
+    return std::ref(data_.slot(write));
+  }
+
+  /// @brief Publishes the slot returned by the last successful try_reserve().
+  /// This method is safe to call from the producer thread only.
+  void commit() {
+    auto write = write_idx_.load(std::memory_order_relaxed);
+    reserved_ = false;
+    instrument_.on_push(data_.index(write));
+    write_idx_.store(write + 1, std::memory_order_release);
+  }
+
+  /// @brief Returns the front element in place without removing it.
+  ///
+  /// The reference stays valid until release() is called.
+  /// @return A reference to the front slot, or std::nullopt if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] std::optional<std::reference_wrapper<const T>> front() {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    if (write_idx_cache_ == read) {
+      write_idx_cache_ = write_idx_.load(std::memory_order_acquire);
+      if (write_idx_cache_ == read)
+        return std::nullopt;
+    }
+    return std::cref(data_.slot(read));
+  }
+
+  /// @brief Destroys the front element returned by the last successful front() and hands
+  /// its slot back to the producer.
+  /// This method is safe to call from the consumer thread only.
+  void release() {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    std::destroy_at(&data_.slot(read));
+    instrument_.on_pop(data_.index(read), write_idx_cache_ - read);
+    read_idx_.store(read + 1, std::memory_order_release);
+  }
+
+  /// @brief Pushes as many values as fit, publishing the write index once.
+  ///
+  /// Wrap-around is handled as at most two contiguous copies (memcpy for
+  /// trivially copyable T, copy construction into the free slots otherwise).
+  /// @param values The values to push (copied, in order).
+  /// @return The number of values pushed, 0 if the queue is full.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] size_t push_n(std::span<const T> values) {
+    auto write = write_idx_.load(std::memory_order_relaxed);
+    if (data_.capacity() - (write - read_idx_cache_) < values.size()) {
+      read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+    }
+    const size_t count = std::min(values.size(), data_.capacity() - (write - read_idx_cache_));
+    if (count == 0)
+      return 0;
+
+    const size_t start = data_.index(write);
+    const size_t first = std::min(count, data_.capacity() - start);
+    construct_elements(values.data(), first, data_.data() + start);
+    construct_elements(values.data() + first, count - first, data_.data());
+    record_push(write, count);
+    write_idx_.store(write + count, std::memory_order_release);
+    return count;
+  }
+
+  /// @brief Pops as many values as available into the span, publishing the read index once.
+  /// @param values The destination for popped values (output, move-assigned from the front).
+  /// @return The number of values popped, 0 if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] size_t pop_n(std::span<T> values) {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    const size_t count = claim_readable(read, values.size());
+    if (count == 0)
+      return 0;
+
+    const size_t start = data_.index(read);
+    const size_t first = std::min(count, data_.capacity() - start);
+    move_elements(data_.data() + start, first, values.data());
+    move_elements(data_.data(), count - first, values.data() + first);
+    record_pop(read, count);
+    read_idx_.store(read + count, std::memory_order_release);
+    return count;
+  }
+
+  /// @brief Pops up to max_count values into an output iterator, publishing the read index once.
+  /// @param out The output iterator values are written to.
+  /// @param max_count The maximum number of values to pop.
+  /// @return The number of values popped, 0 if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  template <std::output_iterator<T&&> OutputIt>
+  [[nodiscard]] size_t pop_n(OutputIt out, size_t max_count) {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    const size_t count = claim_readable(read, max_count);
+    if (count == 0)
+      return 0;
+
+    for (size_t i = 0; i < count; ++i) {
+      T& slot = data_.slot(read + i);
+      *out = std::move(slot);
+      ++out;
+      std::destroy_at(&slot);
+    }
+    record_pop(read, count);
+    read_idx_.store(read + count, std::memory_order_release);
+    return count;
+  }
+
   /// @brief Returns the maximum number of elements the queue can hold.
-  size_t capacity() const { return N; }
+  size_t capacity() const { return data_.capacity(); }
 
   /// @brief Checks if the queue is empty.
   [[nodiscard]] bool empty() const {
@@ -86,15 +425,73 @@ class SpscQueue {
   /// @brief Checks if the queue is full.
   [[nodiscard]] bool full() const {
     return write_idx_.load(std::memory_order_acquire) - read_idx_.load(std::memory_order_acquire) ==
-           N;
+           data_.capacity();
   }
 
+  /// @brief Returns the instrumentation policy, e.g. for snapshot() and reset().
+  Instrument& instrumentation() { return instrument_; }
+
+  /// @brief Returns the instrumentation policy.
+  const Instrument& instrumentation() const { return instrument_; }
+
  private:
-  T data_[N];
+  detail::SpscStorage<T, N> data_;
+  [[no_unique_address]] Instrument instrument_{data_.capacity()};
   alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_idx_{0}; // Producer-owned
   alignas(CACHE_LINE_SIZE) size_t write_idx_cache_{0};        // Producer's cache of read_idx_
   alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_idx_{0};  // Consumer-owned
   alignas(CACHE_LINE_SIZE) size_t read_idx_cache_{0};         // Consumer's cache of write_idx_
+  bool reserved_ = false; // Producer-owned: try_reserve() constructed the slot at write_idx_
+
+  // Returns how many of max_count elements can be read starting at read, refreshing the
+  // cached write index only when the cached view cannot satisfy the whole request.
+  size_t claim_readable(size_t read, size_t max_count) {
+    if (write_idx_cache_ - read < max_count) {
+      write_idx_cache_ = write_idx_.load(std::memory_order_acquire);
+    }
+    return std::min(max_count, write_idx_cache_ - read);
+  }
+
+  // Notifies the instrumentation policy about a batch; empty when it is disabled.
+  void record_push(size_t write, size_t count) {
+    if constexpr (Instrument::enabled) {
+      for (size_t i = 0; i < count; ++i) {
+        instrument_.on_push(data_.index(write + i));
+      }
+    }
+  }
+
+  void record_pop(size_t read, size_t count) {
+    if constexpr (Instrument::enabled) {
+      for (size_t i = 0; i < count; ++i) {
+        instrument_.on_pop(data_.index(read + i), write_idx_cache_ - read - i);
+      }
+    }
+  }
+
+  // Copy-constructs count contiguous elements into free slots, using memcpy when T allows it.
+  static void construct_elements(const T* src, size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (count > 0)
+        std::memcpy(dst, src, count * sizeof(T));
+    } else {
+      std::uninitialized_copy_n(src, count, dst);
+    }
+  }
+
+  // Moves count contiguous elements out of their slots and destroys them, using memcpy
+  // when T allows it.
+  static void move_elements(T* src, size_t count, T* dst) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (count > 0)
+        std::memcpy(dst, src, count * sizeof(T));
+    } else {
+      for (size_t i = 0; i < count; ++i) {
+        dst[i] = std::move(*std::launder(src + i));
+        std::destroy_at(std::launder(src + i));
+      }
+    }
+  }
 };
 
 } // namespace loon
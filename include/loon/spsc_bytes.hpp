@@ -0,0 +1,175 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file spsc_bytes.hpp
+/// @brief Lock-free single-producer single-consumer ring of variable-length byte records.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <span>
+
+namespace loon {
+
+/// @brief A lock-free SPSC ring that stores variable-length, length-prefixed byte records.
+///
+/// SpscBytes uses the same ever-increasing, cached-index scheme as SpscQueue, but the
+/// indices count bytes instead of elements. Each record is an 8-byte header holding the
+/// payload length followed by the payload, padded to 8 bytes. A record is never split
+/// across the wrap point: if it does not fit in the space left before the end of the
+/// buffer, a padding marker is written there and the record starts at offset 0. Both
+/// sides therefore always see one contiguous region per record.
+///
+/// @tparam N The buffer size in bytes (must be a multiple of 8 and at least 32).
+/// @par Example
+/// @code
+/// loon::SpscBytes<4096> ring;
+/// if (auto region = ring.try_reserve(24)) {
+///     std::memcpy(region->data(), msg, 24);  // build in place
+///     ring.commit(24);
+/// }
+/// if (auto record = ring.front()) {
+///     parse(record->data(), record->size());  // read in place
+///     ring.release();
+/// }
+/// @endcode
+template <size_t N>
+class SpscBytes {
+  static_assert(N % 8 == 0, "SpscBytes capacity must be a multiple of 8");
+  static_assert(N >= 32, "SpscBytes capacity must hold a header and payload in half the buffer");
+  static_assert(N <= UINT32_MAX, "SpscBytes capacity must fit the 32-bit length header");
+  static_assert(std::atomic<size_t>::is_always_lock_free, "SpscBytes requires lock-free atomics");
+
+ public:
+  /// @brief Reserves a contiguous region for a record of up to size bytes.
+  ///
+  /// The region is not visible to the consumer until commit() is called. Calling
+  /// try_reserve() again before commit() discards the previous reservation.
+  /// @param size The payload size in bytes.
+  /// @return The writable payload region, or std::nullopt if there is not enough space.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] std::optional<std::span<std::byte>> try_reserve(size_t size) {
+    if (size > max_record_size())
+      return std::nullopt;
+
+    auto write = write_idx_.load(std::memory_order_relaxed);
+    const size_t needed = record_size(size);
+    const size_t tail = N - write % N;
+    // Skip the tail when the record would straddle the wrap point
+    const size_t total = needed <= tail ? needed : tail + needed;
+    if (N - (write - read_idx_cache_) < total) {
+      read_idx_cache_ = read_idx_.load(std::memory_order_acquire);
+      if (N - (write - read_idx_cache_) < total)
+        return std::nullopt;
+    }
+
+    if (needed > tail) {
+      store_header(write % N, PADDING);
+      write += tail;
+    }
+    pending_ = write;
+    return std::span<std::byte>(data_ + write % N + HEADER_SIZE, size);
+  }
+
+  /// @brief Publishes the region returned by the last successful try_reserve().
+  /// @param size The number of bytes written (must not exceed the reserved size).
+  /// This method is safe to call from the producer thread only.
+  void commit(size_t size) {
+    store_header(pending_ % N, static_cast<uint32_t>(size));
+    write_idx_.store(pending_ + record_size(size), std::memory_order_release);
+  }
+
+  /// @brief Copies a record into the ring.
+  /// @param record The payload bytes to push.
+  /// @return true if the record was added, false if there is not enough space.
+  /// This method is safe to call from the producer thread only.
+  [[nodiscard]] bool push(std::span<const std::byte> record) {
+    auto region = try_reserve(record.size());
+    if (!region)
+      return false;
+    if (!record.empty())
+      std::memcpy(region->data(), record.data(), record.size());
+    commit(record.size());
+    return true;
+  }
+
+  /// @brief Returns the payload of the front record in place without removing it.
+  ///
+  /// The region stays valid until release() is called.
+  /// @return The readable payload region, or std::nullopt if the ring is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] std::optional<std::span<const std::byte>> front() {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    for (;;) {
+      if (write_idx_cache_ == read) {
+        write_idx_cache_ = write_idx_.load(std::memory_order_acquire);
+        if (write_idx_cache_ == read)
+          return std::nullopt;
+      }
+      const auto length = load_header(read % N);
+      if (length != PADDING)
+        return std::span<const std::byte>(data_ + read % N + HEADER_SIZE, length);
+
+      // Producer skipped the tail; hand it back and continue at offset 0
+      read += N - read % N;
+      read_idx_.store(read, std::memory_order_release);
+    }
+  }
+
+  /// @brief Releases the record returned by the last successful front() back to the producer.
+  /// This method is safe to call from the consumer thread only.
+  void release() {
+    auto read = read_idx_.load(std::memory_order_relaxed);
+    read_idx_.store(read + record_size(load_header(read % N)), std::memory_order_release);
+  }
+
+  /// @brief Returns the buffer size in bytes, including record headers.
+  size_t capacity() const { return N; }
+
+  /// @brief Returns the largest payload a single record can hold.
+  ///
+  /// A record of up to N / 2 bytes with its header always fits in an empty ring, whatever
+  /// the current offset: if it does not fit before the wrap point, the skipped tail is
+  /// smaller than the record. Larger records could only be placed at particular offsets,
+  /// so a producer retrying one could wait forever.
+  static constexpr size_t max_record_size() { return N / 2 - HEADER_SIZE; }
+
+  /// @brief Checks if the ring holds no records.
+  [[nodiscard]] bool empty() const {
+    return write_idx_.load(std::memory_order_acquire) == read_idx_.load(std::memory_order_acquire);
+  }
+
+ private:
+  static constexpr size_t HEADER_SIZE = 8;
+  static constexpr uint32_t PADDING = UINT32_MAX; // Header marking a skipped tail
+
+  alignas(CACHE_LINE_SIZE) std::byte data_[N];
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_idx_{0}; // Producer-owned
+  alignas(CACHE_LINE_SIZE) size_t write_idx_cache_{0};        // Consumer's cache of write_idx_
+  alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_idx_{0};  // Consumer-owned
+  alignas(CACHE_LINE_SIZE) size_t read_idx_cache_{0};         // Producer's cache of read_idx_
+  size_t pending_{0}; // Producer's reserved record position
+
+  // Header plus payload, rounded up to keep every header 8-byte aligned.
+  static constexpr size_t record_size(size_t size) {
+    return (HEADER_SIZE + size + 7) & ~size_t{7};
+  }
+
+  void store_header(size_t offset, uint32_t length) {
+    std::memcpy(data_ + offset, &length, sizeof(length));
+  }
+
+  uint32_t load_header(size_t offset) const {
+    uint32_t length;
+    std::memcpy(&length, data_ + offset, sizeof(length));
+    return length;
+  }
+};
+
+} // namespace loon
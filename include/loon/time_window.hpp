@@ -0,0 +1,241 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file time_window.hpp
+/// @brief Ring of timestamped elements that expire once they are older than a horizon.
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace loon {
+
+/// @brief What TimeWindow does when a burst fills its storage before anything expires.
+enum class WindowOverflow {
+  Evict, ///< Drop the oldest element early, keeping memory fixed (counted in dropped()).
+  Grow,  ///< Double the storage, keeping every element until it expires.
+};
+
+/// @brief A FIFO window holding the elements pushed during the last horizon.
+///
+/// Every element is stored with a monotonic timestamp. Expiry is lazy: push() and
+/// count() drop the elements that have aged out, and expire() can be called explicitly.
+/// Since timestamps are ordered, expiry finds the cut point with a galloping search from
+/// the oldest element and drops everything before it at once: O(log k) to expire k
+/// trivially destructible elements, O(1) when the stream is steady. An idle gap followed
+/// by a push does not walk the stale elements one by one.
+///
+/// The storage is a power-of-two ring sized for N elements. When a burst exceeds it, the
+/// WindowOverflow policy either evicts the oldest element early or doubles the ring.
+///
+/// @tparam T The element type to store.
+/// @tparam N The initial capacity, rounded up to a power of two (must be > 0).
+/// @tparam Clock The monotonic clock used by push() and count() without a timestamp.
+/// @par Example
+/// @code
+/// using namespace std::chrono_literals;
+/// loon::TimeWindow<Latency, 1024> recent(500ms);      // the last 500 ms
+/// recent.push(latency);
+/// auto rate = recent.count() * 2;                     // per second
+/// recent.for_each([](auto stamp, const Latency& l) { histogram.add(l); });
+/// @endcode
+template <typename T, size_t N, typename Clock = std::chrono::steady_clock>
+class TimeWindow {
+  static_assert(N > 0, "TimeWindow capacity must be greater than 0");
+  static_assert(Clock::is_steady, "TimeWindow requires a monotonic clock");
+
+ public:
+  using value_type = T;
+  using time_point = typename Clock::time_point;
+  using duration = typename Clock::duration;
+
+  /// @brief Constructs an empty window.
+  /// @param horizon How long an element stays in the window after it is pushed.
+  /// @param overflow What to do when the storage is full of unexpired elements.
+  explicit TimeWindow(duration horizon, WindowOverflow overflow = WindowOverflow::Evict)
+      : slots_(allocate(std::bit_ceil(N))), mask_(std::bit_ceil(N) - 1), horizon_(horizon),
+        overflow_(overflow) {}
+
+  ~TimeWindow() {
+    drop(count_);
+    std::allocator<Entry>().deallocate(slots_, mask_ + 1);
+  }
+
+  TimeWindow(const TimeWindow&) = delete;
+  TimeWindow& operator=(const TimeWindow&) = delete;
+
+  /// @brief Expires old elements, then appends a value stamped with Clock::now().
+  /// @param value The value to push (copied).
+  void push(const T& value) { emplace_at(Clock::now(), value); }
+
+  /// @brief Expires old elements, then appends a value stamped with Clock::now().
+  /// @param value The value to push (moved).
+  void push(T&& value) { emplace_at(Clock::now(), std::move(value)); }
+
+  /// @brief Expires old elements, then appends a value with an explicit timestamp.
+  /// @param stamp The value's timestamp, not earlier than the newest element's.
+  /// @param value The value to push (copied).
+  void push_at(time_point stamp, const T& value) { emplace_at(stamp, value); }
+
+  /// @brief Expires old elements, then appends a value with an explicit timestamp.
+  /// @param stamp The value's timestamp, not earlier than the newest element's.
+  /// @param value The value to push (moved).
+  void push_at(time_point stamp, T&& value) { emplace_at(stamp, std::move(value)); }
+
+  /// @brief Expires old elements, then constructs a value in place.
+  /// @param stamp The value's timestamp, not earlier than the newest element's.
+  /// @param args The arguments forwarded to T's constructor.
+  template <typename... Args>
+  void emplace_at(time_point stamp, Args&&... args) {
+    expire(stamp);
+    if (count_ == mask_ + 1) {
+      if (overflow_ == WindowOverflow::Grow) {
+        grow();
+      } else {
+        drop(1);
+        ++dropped_;
+      }
+    }
+    std::construct_at(slot(count_), stamp, std::forward<Args>(args)...);
+    ++count_;
+  }
+
+  /// @brief Drops every element older than the horizon, measured from Clock::now().
+  /// @return The number of elements dropped.
+  size_t expire() { return expire(Clock::now()); }
+
+  /// @brief Drops every element stamped at or before now - horizon.
+  /// @param now The current time.
+  /// @return The number of elements dropped.
+  size_t expire(time_point now) {
+    const time_point cutoff = now - horizon_;
+    if (count_ == 0 || slot(0)->stamp > cutoff)
+      return 0;
+    // Timestamps are ordered: gallop from the front to bracket the first element still in
+    // the window, then binary search the bracket. Costs O(log k) to drop k elements, so a
+    // steady stream that expires one element per push never searches the whole window.
+    size_t lo = 1;
+    size_t hi = 2;
+    while (hi < count_ && slot(hi)->stamp <= cutoff) {
+      lo = hi + 1;
+      hi *= 2;
+    }
+    hi = std::min(hi, count_);
+    while (lo < hi) {
+      const size_t mid = lo + (hi - lo) / 2;
+      if (slot(mid)->stamp > cutoff) {
+        hi = mid;
+      } else {
+        lo = mid + 1;
+      }
+    }
+    drop(lo);
+    return lo;
+  }
+
+  /// @brief Expires old elements, then returns how many remain.
+  [[nodiscard]] size_t count() { return count(Clock::now()); }
+
+  /// @brief Expires elements older than the horizon at now, then returns how many remain.
+  [[nodiscard]] size_t count(time_point now) {
+    expire(now);
+    return count_;
+  }
+
+  /// @brief Calls f(stamp, value) for every stored element, oldest first.
+  ///
+  /// Does not expire anything; call expire() or count() first for a current view.
+  template <typename F>
+  void for_each(F&& f) const {
+    for (size_t i = 0; i < count_; ++i) {
+      const Entry& entry = *slot(i);
+      f(entry.stamp, entry.value);
+    }
+  }
+
+  /// @brief Returns the oldest stored element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> front() const {
+    if (count_ == 0)
+      return std::nullopt;
+    return slot(0)->value;
+  }
+
+  /// @brief Returns the newest stored element, or std::nullopt if empty.
+  [[nodiscard]] std::optional<T> back() const {
+    if (count_ == 0)
+      return std::nullopt;
+    return slot(count_ - 1)->value;
+  }
+
+  /// @brief Returns the number of stored elements, including any not yet expired lazily.
+  [[nodiscard]] size_t size() const { return count_; }
+
+  /// @brief Checks if no elements are stored.
+  [[nodiscard]] bool empty() const { return count_ == 0; }
+
+  /// @brief Returns the current storage capacity (grows under WindowOverflow::Grow).
+  [[nodiscard]] size_t capacity() const { return mask_ + 1; }
+
+  /// @brief Returns the window's horizon.
+  [[nodiscard]] duration horizon() const { return horizon_; }
+
+  /// @brief Returns how many elements WindowOverflow::Evict dropped before they expired.
+  [[nodiscard]] size_t dropped() const { return dropped_; }
+
+ private:
+  struct Entry {
+    template <typename... Args>
+    explicit Entry(time_point at, Args&&... args)
+        : stamp(at), value(std::forward<Args>(args)...) {}
+
+    time_point stamp;
+    T value;
+  };
+
+  Entry* slots_;
+  size_t mask_;
+  size_t head_ = 0; // Slot of the oldest element
+  size_t count_ = 0;
+  size_t dropped_ = 0;
+  duration horizon_;
+  WindowOverflow overflow_;
+
+  static Entry* allocate(size_t capacity) { return std::allocator<Entry>().allocate(capacity); }
+
+  // Returns the slot holding the i-th oldest element.
+  Entry* slot(size_t i) const { return slots_ + ((head_ + i) & mask_); }
+
+  // Destroys the n oldest elements.
+  void drop(size_t n) {
+    if constexpr (!std::is_trivially_destructible_v<Entry>) {
+      for (size_t i = 0; i < n; ++i) {
+        std::destroy_at(slot(i));
+      }
+    }
+    head_ = (head_ + n) & mask_;
+    count_ -= n;
+  }
+
+  // Moves every element, oldest first, into a ring twice the size.
+  void grow() {
+    const size_t capacity = 2 * (mask_ + 1);
+    Entry* slots = allocate(capacity);
+    for (size_t i = 0; i < count_; ++i) {
+      std::construct_at(slots + i, std::move(*slot(i)));
+      std::destroy_at(slot(i));
+    }
+    std::allocator<Entry>().deallocate(slots_, mask_ + 1);
+    slots_ = slots;
+    mask_ = capacity - 1;
+    head_ = 0;
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,141 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file unbounded_spsc.hpp
+/// @brief Unbounded single-producer single-consumer queue built from linked ring segments.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace loon {
+
+/// @brief A lock-free SPSC queue that grows instead of rejecting pushes.
+///
+/// The queue is a chain of segments, each a bounded SpscQueue<T, SegmentSize> plus a link
+/// to the next segment. While the consumer keeps up, both sides stay in the same segment
+/// and push()/pop() cost what they cost on SpscQueue. When the producer's segment fills
+/// up, it takes an empty segment from the recycle cache (or allocates one), writes the
+/// value there and links it in. Once the consumer has drained a segment and moved on, it
+/// hands the segment back through the recycle cache, or frees it when the cache is full,
+/// so a queue that has grown once absorbs the same burst again without allocating.
+///
+/// @tparam T The element type to store.
+/// @tparam SegmentSize The capacity of each segment (must be > 0; a power of two is best).
+/// @par Example
+/// @code
+/// loon::UnboundedSpscQueue<Sample> samples(4);  // four spare segments up front
+/// samples.push(sample);   // producer: never drops, even while the recorder stalls
+/// Sample s;
+/// if (samples.pop(s)) {   // consumer
+///     // use s
+/// }
+/// @endcode
+template <typename T, size_t SegmentSize = 1024>
+class UnboundedSpscQueue {
+  static_assert(SegmentSize > 0, "UnboundedSpscQueue segment size must be greater than 0");
+
+ public:
+  using value_type = T;
+
+  /// @brief The number of drained segments kept for reuse instead of being freed.
+  static constexpr size_t RECYCLE_CAPACITY = 16;
+
+  /// @brief Constructs an empty queue with one segment.
+  /// @param spare_segments Segments to preallocate into the recycle cache (at most
+  ///                       RECYCLE_CAPACITY), so early bursts do not allocate either.
+  /// @throws std::bad_alloc if the segments cannot be allocated.
+  explicit UnboundedSpscQueue(size_t spare_segments = 0) : tail_(new Segment), head_(tail_) {
+    for (size_t i = 0; i < spare_segments && i < RECYCLE_CAPACITY; ++i) {
+      if (!recycled_.push(new Segment))
+        break;
+    }
+  }
+
+  /// @brief Frees every segment, including the recycled ones.
+  ~UnboundedSpscQueue() {
+    for (Segment* segment = head_; segment != nullptr;) {
+      delete std::exchange(segment, segment->next.load(std::memory_order_relaxed));
+    }
+    Segment* segment;
+    while (recycled_.pop(segment)) {
+      delete segment;
+    }
+  }
+
+  UnboundedSpscQueue(const UnboundedSpscQueue&) = delete;
+  UnboundedSpscQueue& operator=(const UnboundedSpscQueue&) = delete;
+
+  /// @brief Pushes a value to the back of the queue, growing it if needed.
+  /// @param value The value to push (copied).
+  /// @throws std::bad_alloc if a new segment is needed and cannot be allocated.
+  /// This method is safe to call from the producer thread only.
+  void push(const T& value) {
+    if (tail_->ring.push(value))
+      return;
+    Segment* segment = next_segment();
+    [[maybe_unused]] const bool pushed = segment->ring.push(value); // Fresh segment is empty
+    tail_->next.store(segment, std::memory_order_release);
+    tail_ = segment;
+  }
+
+  /// @brief Pops a value from the front of the queue.
+  /// @param value The value popped from the queue (output).
+  /// @return true if a value was popped, false if the queue is empty.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] bool pop(T& value) {
+    if (head_->ring.pop(value))
+      return true;
+    Segment* next = head_->next.load(std::memory_order_acquire);
+    if (next == nullptr)
+      return false;
+    // The producer links a segment only after filling this one; drain what is left first
+    if (head_->ring.pop(value))
+      return true;
+    retire(std::exchange(head_, next));
+    return head_->ring.pop(value); // The producer pushed into next before linking it
+  }
+
+  /// @brief Checks if the queue is empty.
+  ///
+  /// Only a snapshot when the producer is pushing concurrently.
+  /// This method is safe to call from the consumer thread only.
+  [[nodiscard]] bool empty() const {
+    return head_->ring.empty() && head_->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+  /// @brief Returns the capacity of a single segment.
+  static constexpr size_t segment_capacity() { return SegmentSize; }
+
+ private:
+  struct Segment {
+    Segment() {} // User-provided so recycling does not zero the slots
+    SpscQueue<T, SegmentSize> ring;
+    alignas(CACHE_LINE_SIZE) std::atomic<Segment*> next{nullptr};
+  };
+
+  alignas(CACHE_LINE_SIZE) Segment* tail_; // Producer-owned
+  alignas(CACHE_LINE_SIZE) Segment* head_; // Consumer-owned
+  SpscQueue<Segment*, RECYCLE_CAPACITY> recycled_; // Drained segments, consumer -> producer
+
+  // Returns an empty segment, reusing a drained one when the consumer has handed one back.
+  Segment* next_segment() {
+    Segment* segment;
+    if (!recycled_.pop(segment))
+      return new Segment;
+    std::destroy_at(segment);
+    return std::construct_at(segment);
+  }
+
+  void retire(Segment* segment) {
+    if (!recycled_.push(segment))
+      delete segment;
+  }
+};
+
+} // namespace loon
@@ -0,0 +1,285 @@
+// Copyright (c) 2026 Jorge Suarez-Rivaya
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+/// @file wait.hpp
+/// @brief Wait strategies, a spinlock and a blocking wrapper for the lock-free queues.
+
+#include <loon/spsc.hpp>
+
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <linux/membarrier.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace loon {
+
+/// @brief Hints the CPU that the caller is spinning (PAUSE on x86, YIELD on ARM).
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+  _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+  asm volatile("yield");
+#endif
+}
+
+namespace detail {
+
+/// @brief Registers the process for expedited membarrier() once.
+/// @return true if heavy_fence() can force a full barrier on every running thread.
+inline bool enable_asymmetric_fence() {
+#ifdef __linux__
+  static const bool enabled =
+      ::syscall(SYS_membarrier, MEMBARRIER_CMD_REGISTER_PRIVATE_EXPEDITED, 0, 0) == 0;
+  return enabled;
+#else
+  return false;
+#endif
+}
+
+// Fast-path side of a Dekker-style handshake. With membarrier() the slow side does the
+// hardware fence for both threads, so a compiler barrier is enough here.
+inline void light_fence(bool asymmetric) {
+  if (asymmetric) {
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } else {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+// Slow-path side: a full barrier on this thread and on every other running thread.
+inline void heavy_fence(bool asymmetric) {
+#ifdef __linux__
+  if (asymmetric && ::syscall(SYS_membarrier, MEMBARRIER_CMD_PRIVATE_EXPEDITED, 0, 0) == 0)
+    return;
+#endif
+  (void)asymmetric;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+} // namespace detail
+
+/// @brief Wait strategy that busy-spins with cpu_relax().
+///
+/// Lowest wake-up latency, but the waiting thread keeps its core at 100%.
+struct SpinWait {
+  /// @brief Calls op until it returns true.
+  template <typename Op>
+  void wait(Op&& op) {
+    while (!op()) {
+      cpu_relax();
+    }
+  }
+
+  /// @brief No-op: spinning waiters need no wake-up.
+  void notify() {}
+};
+
+/// @brief Wait strategy that spins for a while, then yields the CPU between attempts.
+/// @tparam Spins Number of cpu_relax() attempts before falling back to yielding.
+template <uint32_t Spins = 128>
+struct YieldWait {
+  /// @brief Calls op until it returns true.
+  template <typename Op>
+  void wait(Op&& op) {
+    for (uint32_t i = 0; i < Spins; ++i) {
+      if (op())
+        return;
+      cpu_relax();
+    }
+    while (!op()) {
+      std::this_thread::yield();
+    }
+  }
+
+  /// @brief No-op: yielding waiters poll and need no wake-up.
+  void notify() {}
+};
+
+/// @brief Test-and-test-and-set spinlock for short critical sections.
+///
+/// Satisfies Lockable, so it works with std::lock_guard and std::unique_lock. Waiters spin
+/// on a plain load, so the lock's cache line stays shared until it is released, and yield
+/// after Spins attempts so oversubscribed threads let the holder run.
+/// @tparam Spins Number of cpu_relax() attempts before yielding between attempts.
+template <uint32_t Spins = 128>
+class SpinLock {
+ public:
+  /// @brief Acquires the lock, spinning and then yielding while it is held.
+  void lock() {
+    uint32_t spins = 0;
+    while (!try_lock()) {
+      while (locked_.load(std::memory_order_relaxed)) {
+        if (spins < Spins) {
+          ++spins;
+          cpu_relax();
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    }
+  }
+
+  /// @brief Acquires the lock if it is free.
+  /// @return true if the lock was acquired.
+  [[nodiscard]] bool try_lock() { return !locked_.exchange(true, std::memory_order_acquire); }
+
+  /// @brief Releases the lock.
+  void unlock() { locked_.store(false, std::memory_order_release); }
+
+ private:
+  std::atomic<bool> locked_{false};
+};
+
+/// @brief Wait strategy that spins for a while, then parks the thread on a futex.
+///
+/// notify() only issues a wake system call when a waiter has actually parked; otherwise
+/// it costs one relaxed load. The store/load handshake with a parking waiter is made safe
+/// by membarrier(), which the waiter issues on its way to sleep, so notify() needs only a
+/// compiler barrier; where membarrier() is unavailable both sides use a seq_cst fence.
+/// Falls back to std::atomic::wait outside Linux.
+/// @tparam Spins Number of cpu_relax() attempts before parking.
+template <uint32_t Spins = 128>
+class ParkWait {
+ public:
+  /// @brief Calls op until it returns true, parking between attempts once spinning is done.
+  template <typename Op>
+  void wait(Op&& op) {
+    for (uint32_t i = 0; i < Spins; ++i) {
+      if (op())
+        return;
+      cpu_relax();
+    }
+    for (;;) {
+      const auto epoch = epoch_.load(std::memory_order_acquire);
+      waiters_.fetch_add(1, std::memory_order_seq_cst);
+      detail::heavy_fence(asymmetric_);
+      if (op()) {
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+        return;
+      }
+      park(epoch);
+      waiters_.fetch_sub(1, std::memory_order_relaxed);
+      if (op())
+        return;
+    }
+  }
+
+  /// @brief Wakes parked waiters, if any. Call after every state change they may wait on.
+  void notify() {
+    // Pairs with the fence in wait(): either the waiter sees the new state, or we see it.
+    detail::light_fence(asymmetric_);
+    if (waiters_.load(std::memory_order_relaxed) == 0)
+      return;
+    epoch_.fetch_add(1, std::memory_order_release);
+    wake();
+  }
+
+ private:
+  alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> epoch_{0};   // Bumped on every wake
+  std::atomic<uint32_t> waiters_{0};                          // Threads parked or parking
+  const bool asymmetric_ = detail::enable_asymmetric_fence(); // notify() needs no fence
+
+  void park(uint32_t epoch) {
+#ifdef __linux__
+    ::syscall(SYS_futex, &epoch_, FUTEX_WAIT_PRIVATE, epoch, nullptr, nullptr, 0);
+#else
+    epoch_.wait(epoch, std::memory_order_acquire);
+#endif
+  }
+
+  void wake() {
+#ifdef __linux__
+    ::syscall(SYS_futex, &epoch_, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+    epoch_.notify_all();
+#endif
+  }
+};
+
+/// @brief Adds blocking push_wait()/pop_wait() to a lock-free queue.
+///
+/// Wraps any queue with `bool push(const T&)` and `bool pop(T&)` (such as SpscQueue) and
+/// waits with the given strategy when the queue is full or empty. Every successful push
+/// notifies blocked consumers and every successful pop notifies blocked producers, so all
+/// access must go through the wrapper. The threading rules of the wrapped queue still apply.
+///
+/// @tparam Queue The wrapped queue type.
+/// @tparam Wait The wait strategy: SpinWait, YieldWait or ParkWait.
+/// @par Example
+/// @code
+/// loon::BlockingQueue<loon::SpscQueue<int, 1024>, loon::ParkWait<>> queue;
+/// queue.push_wait(42);     // producer, blocks while full
+/// int value;
+/// queue.pop_wait(value);   // consumer, blocks while empty
+/// @endcode
+template <typename Queue, typename Wait = SpinWait>
+class BlockingQueue {
+ public:
+  using value_type = typename Queue::value_type;
+
+  /// @brief Constructs the wrapped queue from the given arguments.
+  template <typename... Args>
+  explicit BlockingQueue(Args&&... args) : queue_(std::forward<Args>(args)...) {}
+
+  /// @brief Pushes a value, waiting while the queue is full.
+  /// @param value The value to push (copied).
+  void push_wait(const value_type& value) {
+    not_full_.wait([&] { return queue_.push(value); });
+    not_empty_.notify();
+  }
+
+  /// @brief Pops a value, waiting while the queue is empty.
+  /// @param value The value popped from the queue (output).
+  void pop_wait(value_type& value) {
+    not_empty_.wait([&] { return queue_.pop(value); });
+    not_full_.notify();
+  }
+
+  /// @brief Pushes a value without waiting.
+  /// @return true if the value was added, false if the queue is full.
+  [[nodiscard]] bool push(const value_type& value) {
+    if (!queue_.push(value))
+      return false;
+    not_empty_.notify();
+    return true;
+  }
+
+  /// @brief Pops a value without waiting.
+  /// @return true if a value was popped, false if the queue is empty.
+  [[nodiscard]] bool pop(value_type& value) {
+    if (!queue_.pop(value))
+      return false;
+    not_full_.notify();
+    return true;
+  }
+
+  /// @brief Returns the maximum number of elements the queue can hold.
+  size_t capacity() const { return queue_.capacity(); }
+
+  /// @brief Checks if the queue is empty.
+  [[nodiscard]] bool empty() const { return queue_.empty(); }
+
+  /// @brief Checks if the queue is full.
+  [[nodiscard]] bool full() const { return queue_.full(); }
+
+ private:
+  Queue queue_;
+  Wait not_empty_; // Consumers wait here, producers notify
+  Wait not_full_;  // Producers wait here, consumers notify
+};
+
+} // namespace loon
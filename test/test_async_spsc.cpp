@@ -0,0 +1,129 @@
+#include <loon/async_spsc.hpp>
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+// Eagerly started coroutine that nobody awaits; enough to drive the queue in tests
+struct Detached {
+  struct promise_type {
+    Detached get_return_object() { return {}; }
+    std::suspend_never initial_suspend() noexcept { return {}; }
+    std::suspend_never final_suspend() noexcept { return {}; }
+    void return_void() {}
+    void unhandled_exception() { std::terminate(); }
+  };
+};
+
+// Collects resumed handles so the test decides when the consumer runs
+struct ManualExecutor {
+  std::vector<std::coroutine_handle<>>* handles;
+  void operator()(std::coroutine_handle<> handle) const { handles->push_back(handle); }
+};
+
+template <typename Queue>
+Detached consume(Queue& queue, int count, std::vector<int>& received) {
+  for (int i = 0; i < count; ++i) {
+    received.push_back(co_await queue.pop_async());
+  }
+}
+
+TEST(AsyncSpscQueueTest, ReadyValueDoesNotSuspend) {
+  std::vector<std::coroutine_handle<>> handles;
+  loon::AsyncSpscQueue<int, 4, ManualExecutor> queue(ManualExecutor{&handles});
+  ASSERT_TRUE(queue.push(1));
+  ASSERT_TRUE(queue.push(2));
+
+  std::vector<int> received;
+  consume(queue, 2, received);
+  EXPECT_EQ(received, (std::vector<int>{1, 2}));
+  EXPECT_TRUE(handles.empty());
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST(AsyncSpscQueueTest, PushResumesSuspendedConsumer) {
+  std::vector<std::coroutine_handle<>> handles;
+  loon::AsyncSpscQueue<int, 4, ManualExecutor> queue(ManualExecutor{&handles});
+
+  std::vector<int> received;
+  consume(queue, 2, received);
+  EXPECT_TRUE(received.empty()); // suspended on the empty queue
+
+  ASSERT_TRUE(queue.push(7));
+  ASSERT_EQ(handles.size(), 1);
+  EXPECT_TRUE(received.empty()); // not resumed until the executor runs it
+
+  handles.back().resume();
+  EXPECT_EQ(received, (std::vector<int>{7}));
+
+  ASSERT_TRUE(queue.push(8));
+  ASSERT_EQ(handles.size(), 2);
+  handles.back().resume();
+  EXPECT_EQ(received, (std::vector<int>{7, 8}));
+}
+
+TEST(AsyncSpscQueueTest, PushWithoutWaiterSkipsExecutor) {
+  std::vector<std::coroutine_handle<>> handles;
+  loon::AsyncSpscQueue<int, 2, ManualExecutor> queue(ManualExecutor{&handles});
+  ASSERT_TRUE(queue.push(1));
+  ASSERT_TRUE(queue.push(2));
+  EXPECT_FALSE(queue.push(3));
+  EXPECT_TRUE(handles.empty());
+
+  int actual(-1);
+  ASSERT_TRUE(queue.pop(actual));
+  EXPECT_EQ(actual, 1);
+}
+
+// The consumer suspends on the main thread and is resumed inline on the producer thread
+TEST(AsyncSpscQueueTest, InlineExecutorAcrossThreads) {
+  loon::AsyncSpscQueue<int, 16> queue;
+  constexpr int count = 10000;
+  std::vector<int> received;
+  received.reserve(count);
+
+  std::thread producer([&] {
+    for (int i = 0; i < count; ++i) {
+      while (!queue.push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  });
+  consume(queue, count, received);
+  producer.join();
+
+  ASSERT_EQ(received.size(), static_cast<size_t>(count));
+  for (int i = 0; i < count; ++i) {
+    EXPECT_EQ(received[i], i);
+  }
+}
+
+// Many short suspensions so push() and a suspending consumer keep racing for the handle;
+// meant to be run under ThreadSanitizer as well
+TEST(AsyncSpscQueueTest, SuspendResumeStress) {
+  constexpr int rounds = 200;
+  constexpr int count = 1000;
+  for (int round = 0; round < rounds; ++round) {
+    loon::AsyncSpscQueue<int, 2> queue;
+    std::vector<int> received;
+    received.reserve(count);
+
+    std::thread producer([&] {
+      for (int i = 0; i < count; ++i) {
+        while (!queue.push(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+    consume(queue, count, received);
+    producer.join();
+
+    ASSERT_EQ(received.size(), static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+      ASSERT_EQ(received[i], i);
+    }
+  }
+}
@@ -0,0 +1,112 @@
+#include <loon/broadcast.hpp>
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class BroadcastRingTest : public ::testing::Test {
+ protected:
+  loon::BroadcastRing<int, 4> ring;
+};
+
+TEST_F(BroadcastRingTest, EveryConsumerSeesEveryMessage) {
+  auto& first = ring.add_consumer();
+  auto& second = ring.add_consumer();
+  EXPECT_EQ(ring.consumers(), 2);
+
+  ASSERT_TRUE(ring.push(1));
+  ASSERT_TRUE(ring.push(2));
+
+  int actual(-1);
+  for (auto* consumer : {&first, &second}) {
+    ASSERT_TRUE(consumer->pop(actual));
+    EXPECT_EQ(actual, 1);
+    ASSERT_TRUE(consumer->pop(actual));
+    EXPECT_EQ(actual, 2);
+    EXPECT_FALSE(consumer->pop(actual));
+  }
+}
+
+TEST_F(BroadcastRingTest, ProducerGatesOnSlowestConsumer) {
+  auto& fast = ring.add_consumer();
+  auto& slow = ring.add_consumer();
+
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.push(i));
+  }
+  int actual(-1);
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(fast.pop(actual));
+  }
+  EXPECT_FALSE(ring.push(4)); // slow consumer still holds every slot
+
+  ASSERT_TRUE(slow.pop(actual));
+  EXPECT_EQ(actual, 0);
+  EXPECT_TRUE(ring.push(4));
+  EXPECT_FALSE(ring.push(5));
+}
+
+TEST_F(BroadcastRingTest, DependencyBarrier) {
+  auto& risk = ring.add_consumer();
+  auto& strategy = ring.add_consumer();
+  auto& recorder = ring.add_consumer({&risk, &strategy});
+
+  ASSERT_TRUE(ring.push(7));
+  int actual(-1);
+  EXPECT_FALSE(recorder.pop(actual)); // neither dependency has released it
+
+  ASSERT_TRUE(risk.pop(actual));
+  EXPECT_FALSE(recorder.pop(actual)); // strategy still has it
+
+  ASSERT_TRUE(strategy.pop(actual));
+  ASSERT_TRUE(recorder.pop(actual));
+  EXPECT_EQ(actual, 7);
+}
+
+TEST_F(BroadcastRingTest, InPlaceReserveAndFront) {
+  auto& consumer = ring.add_consumer();
+  EXPECT_FALSE(consumer.front().has_value());
+
+  auto slot = ring.try_reserve();
+  ASSERT_TRUE(slot.has_value());
+  slot->get() = 3;
+  EXPECT_EQ(consumer.available(), 0); // not visible until committed
+  ring.commit();
+  EXPECT_EQ(consumer.available(), 1);
+
+  auto front = consumer.front();
+  ASSERT_TRUE(front.has_value());
+  EXPECT_EQ(front->get(), 3);
+  consumer.release();
+  EXPECT_EQ(consumer.available(), 0);
+}
+
+TEST(BroadcastRingConcurrencyTest, ChainedConsumers) {
+  constexpr int count = 20000;
+  loon::BroadcastRing<int, 64> ring;
+  auto& first = ring.add_consumer();
+  auto& second = ring.add_consumer();
+  auto& last = ring.add_consumer({&first, &second});
+
+  std::vector<std::thread> threads;
+  for (auto* consumer : {&first, &second, &last}) {
+    threads.emplace_back([consumer] {
+      int actual;
+      for (int i = 0; i < count; ++i) {
+        while (!consumer->pop(actual)) {
+          std::this_thread::yield();
+        }
+        ASSERT_EQ(actual, i);
+      }
+    });
+  }
+
+  for (int i = 0; i < count; ++i) {
+    while (!ring.push(i)) {
+      std::this_thread::yield();
+    }
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
@@ -0,0 +1,159 @@
+#include <loon/clock_cache.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ClockCacheTest : public ::testing::Test {
+ protected:
+  loon::ClockCache<int, int> cache{3};
+};
+
+TEST_F(ClockCacheTest, PutAndGet) {
+  cache.put(1, 10);
+  auto result = cache.get(1);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, 10);
+  EXPECT_FALSE(cache.get(2).has_value());
+}
+
+TEST_F(ClockCacheTest, ExistsAndRemove) {
+  cache.put(1, 10);
+  EXPECT_TRUE(cache.exists(1));
+  EXPECT_FALSE(cache.exists(2));
+  cache.remove(1);
+  cache.remove(2);
+  EXPECT_FALSE(cache.exists(1));
+  EXPECT_EQ(cache.size(), 0);
+}
+
+TEST_F(ClockCacheTest, UpdateExistingKey) {
+  cache.put(1, 10);
+  cache.put(1, 11);
+  EXPECT_EQ(*cache.get(1), 11);
+  EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(ClockCacheTest, EvictsUnreferencedEntry) {
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  cache.get(1); // Second chance for key 1
+
+  cache.put(4, 40); // Hand clears key 1's bit, then evicts key 2
+  EXPECT_TRUE(cache.exists(1));
+  EXPECT_FALSE(cache.exists(2));
+  EXPECT_TRUE(cache.exists(3));
+  EXPECT_TRUE(cache.exists(4));
+  EXPECT_EQ(cache.size(), 3);
+}
+
+TEST_F(ClockCacheTest, ExistsDoesNotReference) {
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  EXPECT_TRUE(cache.exists(1));
+
+  cache.put(4, 40); // Key 1 was only checked, so it goes first
+  EXPECT_FALSE(cache.exists(1));
+}
+
+TEST_F(ClockCacheTest, RemoveFreesCapacity) {
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  cache.remove(2);
+
+  cache.put(4, 40); // Reuses the removed entry, no eviction
+  EXPECT_TRUE(cache.exists(1));
+  EXPECT_TRUE(cache.exists(3));
+  EXPECT_TRUE(cache.exists(4));
+  EXPECT_EQ(cache.size(), 3);
+}
+
+// Random puts and removes below capacity: nothing is evicted, so the cache must match a
+// map exactly while tombstones pile up and force index rebuilds
+TEST(ClockCacheIndexTest, MatchesMapAcrossRebuilds) {
+  loon::ClockCache<uint32_t, uint32_t> cache(256);
+  std::unordered_map<uint32_t, uint32_t> model;
+  std::mt19937 rng(5);
+  std::uniform_int_distribution<uint32_t> key(0, 1000);
+
+  for (uint32_t step = 0; step < 200000; ++step) {
+    const auto k = key(rng);
+    if (model.size() < 200 && step % 2 == 0) {
+      cache.put(k, step);
+      model[k] = step;
+    } else {
+      cache.remove(k);
+      model.erase(k);
+    }
+    ASSERT_EQ(cache.size(), model.size());
+  }
+  for (uint32_t k = 0; k <= 1000; ++k) {
+    const auto value = cache.get(k);
+    ASSERT_EQ(value.has_value(), model.count(k) == 1) << k;
+    if (value) {
+      EXPECT_EQ(*value, model[k]);
+    }
+  }
+}
+
+TEST(ClockCacheIndexTest, CollidingKeysSurviveEviction) {
+  loon::ClockCache<uint64_t, uint64_t> cache(64);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    cache.put(i << 32, i);
+    ASSERT_EQ(*cache.get(i << 32), i);
+    ASSERT_LE(cache.size(), 64);
+  }
+}
+
+// Readers must never see a torn value or a value stored under another key while a
+// writer keeps updating, evicting and removing
+TEST(ClockCacheConcurrencyTest, ReadersSeeConsistentEntries) {
+  struct Pair {
+    uint64_t key;
+    uint64_t check;
+  };
+  loon::ClockCache<uint64_t, Pair> cache(128);
+  std::atomic<bool> done{false};
+  std::atomic<uint64_t> hits{0};
+
+  std::vector<std::thread> readers;
+  for (int t = 0; t < 4; ++t) {
+    readers.emplace_back([&, t] {
+      uint64_t local = 0;
+      for (uint64_t i = static_cast<uint64_t>(t); !done.load(std::memory_order_relaxed); ++i) {
+        const uint64_t k = i % 512;
+        if (auto value = cache.get(k)) {
+          ASSERT_EQ(value->key, k);
+          ASSERT_EQ(value->check, ~value->key);
+          ++local;
+        }
+      }
+      hits.fetch_add(local);
+    });
+  }
+
+  std::thread writer([&] {
+    for (uint64_t i = 0; i < 300000; ++i) {
+      const uint64_t k = (i * 7) % 512;
+      if (i % 16 == 0)
+        cache.remove(k);
+      else
+        cache.put(k, Pair{k, ~k});
+    }
+    done.store(true);
+  });
+
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+  EXPECT_GT(hits.load(), 0);
+  EXPECT_LE(cache.size(), 128);
+}
@@ -0,0 +1,108 @@
+#include <loon/fan_in.hpp>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using Poller = loon::FanInPoller<int, 8, 128>;
+
+TEST(FanInPollerTest, PollsOnlyReadyQueues) {
+  Poller poller;
+  std::vector<Poller::Producer*> producers;
+  for (int i = 0; i < 100; ++i) {
+    producers.push_back(&poller.add_producer());
+  }
+  EXPECT_EQ(poller.producers(), 100);
+
+  ASSERT_TRUE(producers[3]->push(30));
+  ASSERT_TRUE(producers[70]->push(700));
+  ASSERT_TRUE(producers[70]->push(701));
+
+  std::vector<std::pair<size_t, int>> seen;
+  EXPECT_EQ(poller.poll([&](size_t index, int value) { seen.emplace_back(index, value); }), 3);
+  EXPECT_EQ(seen, (std::vector<std::pair<size_t, int>>{{3, 30}, {70, 700}, {70, 701}}));
+
+  EXPECT_EQ(poller.poll([](size_t, int) { FAIL(); }), 0);
+}
+
+TEST(FanInPollerTest, BatchLimitRearmsQueue) {
+  Poller poller;
+  auto& busy = poller.add_producer();
+  auto& quiet = poller.add_producer();
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_TRUE(busy.push(i));
+  }
+  ASSERT_TRUE(quiet.push(100));
+
+  std::vector<int> seen;
+  auto collect = [&](size_t, int value) { seen.push_back(value); };
+  EXPECT_EQ(poller.poll(collect, 2), 3);
+  EXPECT_EQ(seen, (std::vector<int>{0, 1, 100}));
+
+  EXPECT_EQ(poller.poll(collect, 2), 2);
+  EXPECT_EQ(poller.poll(collect, 2), 1);
+  EXPECT_EQ(poller.poll(collect, 2), 0);
+  EXPECT_EQ(seen, (std::vector<int>{0, 1, 100, 2, 3, 4}));
+}
+
+TEST(FanInPollerTest, PushRearmsAfterDrain) {
+  Poller poller;
+  auto& producer = poller.add_producer();
+  EXPECT_EQ(producer.index(), 0);
+
+  int total = 0;
+  auto sum = [&](size_t, int value) { total += value; };
+  ASSERT_TRUE(producer.push(1));
+  EXPECT_EQ(poller.poll(sum), 1);
+  ASSERT_TRUE(producer.push(2));
+  EXPECT_EQ(poller.poll(sum), 1);
+  EXPECT_EQ(total, 3);
+}
+
+TEST(FanInPollerTest, FullQueueRejectsPush) {
+  loon::FanInPoller<int, 2, 1> poller;
+  auto& producer = poller.add_producer();
+  ASSERT_TRUE(producer.push(1));
+  ASSERT_TRUE(producer.push(2));
+  EXPECT_FALSE(producer.push(3));
+  EXPECT_THROW(poller.add_producer(), std::length_error);
+}
+
+TEST(FanInPollerTest, ConcurrentProducers) {
+  Poller poller;
+  constexpr int producers = 4;
+  constexpr int count = 10000;
+  std::vector<Poller::Producer*> handles;
+  for (int p = 0; p < producers; ++p) {
+    handles.push_back(&poller.add_producer());
+  }
+
+  std::vector<std::thread> threads;
+  for (auto* handle : handles) {
+    threads.emplace_back([handle] {
+      for (int i = 0; i < count; ++i) {
+        while (!handle->push(i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> next(producers, 0);
+  int received = 0;
+  while (received < producers * count) {
+    const auto handled = poller.poll([&](size_t index, int value) {
+      EXPECT_EQ(value, next[index]);
+      ++next[index];
+    });
+    received += static_cast<int>(handled);
+    if (handled == 0)
+      std::this_thread::yield();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(poller.poll([](size_t, int) {}), 0);
+}
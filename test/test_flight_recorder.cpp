@@ -0,0 +1,183 @@
+#include <loon/flight_recorder.hpp>
+
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using Recorder = loon::FlightRecorder<uint64_t, 8>;
+
+static std::vector<uint64_t> sequences(const Recorder& recorder) {
+  std::vector<uint64_t> seen;
+  recorder.for_each([&](uint64_t sequence, uint64_t value) {
+    EXPECT_EQ(value, sequence * 10);
+    seen.push_back(sequence);
+  });
+  return seen;
+}
+
+TEST(FlightRecorderTest, EmptyRecorder) {
+  Recorder recorder;
+  EXPECT_EQ(recorder.capacity(), 8);
+  EXPECT_EQ(recorder.written(), 0);
+  EXPECT_EQ(recorder.lost(), 0);
+  uint64_t value;
+  EXPECT_FALSE(recorder.read(0, value));
+  EXPECT_TRUE(sequences(recorder).empty());
+}
+
+TEST(FlightRecorderTest, ReadsBySequence) {
+  Recorder recorder;
+  for (uint64_t i = 0; i < 3; ++i) {
+    recorder.push(i * 10);
+  }
+  uint64_t value;
+  ASSERT_TRUE(recorder.read(1, value));
+  EXPECT_EQ(value, 10);
+  EXPECT_FALSE(recorder.read(3, value)); // not written yet
+  EXPECT_EQ(sequences(recorder), (std::vector<uint64_t>{0, 1, 2}));
+}
+
+TEST(FlightRecorderTest, OverwritesOldestEntries) {
+  Recorder recorder;
+  for (uint64_t i = 0; i < 20; ++i) {
+    recorder.push(i * 10);
+  }
+  EXPECT_EQ(recorder.written(), 20);
+  EXPECT_EQ(recorder.lost(), 0);
+  uint64_t value;
+  EXPECT_FALSE(recorder.read(11, value)); // overwritten by 19
+  EXPECT_EQ(sequences(recorder), (std::vector<uint64_t>{12, 13, 14, 15, 16, 17, 18, 19}));
+}
+
+TEST(FlightRecorderTest, NonPowerOfTwoCapacity) {
+  loon::FlightRecorder<uint64_t, 5> recorder;
+  for (uint64_t i = 0; i < 12; ++i) {
+    recorder.push(i);
+  }
+  std::vector<uint64_t> seen;
+  EXPECT_EQ(recorder.for_each([&](uint64_t, uint64_t value) { seen.push_back(value); }), 5);
+  EXPECT_EQ(seen, (std::vector<uint64_t>{7, 8, 9, 10, 11}));
+}
+
+// Every entry has all fields equal to its sequence-derived tag, so a torn copy shows up as
+// mismatched fields
+TEST(FlightRecorderTest, ConcurrentWritersNeverTearEntries) {
+  using Event = std::array<uint64_t, 8>;
+  constexpr int writers = 4;
+  constexpr uint64_t per_writer = 50000;
+  auto recorder = std::make_unique<loon::FlightRecorder<Event, 1024>>();
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+
+  std::thread reader([&] {
+    while (!done.load(std::memory_order_acquire)) {
+      recorder->for_each([&](uint64_t, const Event& event) {
+        for (auto field : event) {
+          if (field != event[0])
+            torn.fetch_add(1, std::memory_order_relaxed);
+        }
+      });
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (int w = 0; w < writers; ++w) {
+    threads.emplace_back([&, w] {
+      for (uint64_t i = 0; i < per_writer; ++i) {
+        Event event;
+        event.fill((static_cast<uint64_t>(w) << 32) | i);
+        recorder->push(event);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  done.store(true, std::memory_order_release);
+  reader.join();
+
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(recorder->written(), writers * per_writer);
+  // Once writers are quiet, every slot holds the newest lap unless its writer was dropped
+  const size_t intact = recorder->for_each([](uint64_t, const Event&) {});
+  EXPECT_GE(intact + recorder->lost(), recorder->capacity());
+}
+
+// ----------------------------------------------------------------------------
+// dump()
+// ----------------------------------------------------------------------------
+
+struct Dump {
+  Recorder::DumpHeader header;
+  std::vector<Recorder::Record> records;
+};
+
+static Dump dump_and_load(const Recorder& recorder) {
+  std::FILE* file = std::tmpfile();
+  EXPECT_NE(file, nullptr);
+  const int fd = fileno(file);
+  const ssize_t written = recorder.dump(fd);
+  EXPECT_GE(written, 0);
+
+  Dump dump{};
+  EXPECT_EQ(::pread(fd, &dump.header, sizeof(dump.header), 0),
+            static_cast<ssize_t>(sizeof(dump.header)));
+  dump.records.resize(static_cast<size_t>(written));
+  const auto bytes = static_cast<ssize_t>(dump.records.size() * sizeof(Recorder::Record));
+  EXPECT_EQ(::pread(fd, dump.records.data(), static_cast<size_t>(bytes), sizeof(dump.header)),
+            bytes);
+  std::fclose(file);
+  return dump;
+}
+
+TEST(FlightRecorderTest, DumpWritesHeaderAndRecords) {
+  Recorder recorder;
+  for (uint64_t i = 0; i < 11; ++i) {
+    recorder.push(i * 10);
+  }
+  const auto dump = dump_and_load(recorder);
+  EXPECT_EQ(dump.header.magic, Recorder::MAGIC);
+  EXPECT_EQ(dump.header.version, Recorder::VERSION);
+  EXPECT_EQ(dump.header.record_size, sizeof(Recorder::Record));
+  EXPECT_EQ(dump.header.capacity, 8);
+  EXPECT_EQ(dump.header.written, 11);
+  EXPECT_EQ(dump.header.lost, 0);
+  ASSERT_EQ(dump.records.size(), 8);
+  for (size_t i = 0; i < dump.records.size(); ++i) {
+    EXPECT_EQ(dump.records[i].sequence, i + 3);
+    EXPECT_EQ(dump.records[i].value, (i + 3) * 10);
+  }
+}
+
+TEST(FlightRecorderTest, DumpSpansSeveralBatches) {
+  using Large = loon::FlightRecorder<uint64_t, 4096>;
+  auto recorder = std::make_unique<Large>();
+  for (uint64_t i = 0; i < 5000; ++i) {
+    recorder->push(i);
+  }
+  std::FILE* file = std::tmpfile();
+  ASSERT_NE(file, nullptr);
+  EXPECT_EQ(recorder->dump(fileno(file)), 4096);
+  std::fseek(file, 0, SEEK_END);
+  EXPECT_EQ(static_cast<size_t>(std::ftell(file)),
+            sizeof(Large::DumpHeader) + 4096 * sizeof(Large::Record));
+  std::fclose(file);
+}
+
+TEST(FlightRecorderTest, DumpReportsWriteErrors) {
+  Recorder recorder;
+  recorder.push(1);
+  int fds[2];
+  ASSERT_EQ(::pipe(fds), 0);
+  ::close(fds[1]);
+  EXPECT_EQ(recorder.dump(fds[0]), -1); // read end is not writable
+  EXPECT_EQ(errno, EBADF);
+  ::close(fds[0]);
+}
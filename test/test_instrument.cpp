@@ -0,0 +1,55 @@
+#include <loon/instrument.hpp>
+
+#include <cstdint>
+#include <gtest/gtest.h>
+
+using Dwell = loon::DwellInstrumentation;
+
+TEST(DwellInstrumentationTest, SmallValuesHaveExactBuckets) {
+  for (uint64_t ticks = 0; ticks < 32; ++ticks) {
+    EXPECT_EQ(Dwell::bucket(ticks), ticks);
+    EXPECT_EQ(Dwell::bucket_floor(ticks), ticks);
+  }
+}
+
+TEST(DwellInstrumentationTest, BucketsAreLogLinear) {
+  EXPECT_EQ(Dwell::bucket(32), 32);
+  EXPECT_EQ(Dwell::bucket(33), 32); // two values per bucket between 32 and 63
+  EXPECT_EQ(Dwell::bucket(34), 33);
+  EXPECT_EQ(Dwell::bucket(UINT64_MAX), Dwell::BUCKETS - 1);
+
+  for (uint64_t ticks : {uint64_t{100}, uint64_t{4096}, uint64_t{123456789}}) {
+    const auto bucket = Dwell::bucket(ticks);
+    EXPECT_LE(Dwell::bucket_floor(bucket), ticks);
+    EXPECT_GT(Dwell::bucket_floor(bucket + 1), ticks);
+    // Relative bucket width stays within 1/16
+    EXPECT_LE((Dwell::bucket_floor(bucket + 1) - Dwell::bucket_floor(bucket)) * 16, ticks);
+  }
+}
+
+TEST(DwellInstrumentationTest, Percentiles) {
+  Dwell::Snapshot snapshot;
+  EXPECT_EQ(snapshot.percentile(0.5), 0);
+
+  snapshot.counts[Dwell::bucket(10)] = 90;
+  snapshot.counts[Dwell::bucket(1000)] = 10;
+  snapshot.total = 100;
+  EXPECT_EQ(snapshot.percentile(0.5), 10);
+  EXPECT_EQ(snapshot.percentile(0.89), 10);
+  const auto p99 = snapshot.percentile(0.99);
+  EXPECT_GE(p99, 1000);
+  EXPECT_LT(p99, 1000 + 1000 / 16);
+  EXPECT_EQ(snapshot.percentile(1.0), p99);
+}
+
+TEST(DwellInstrumentationTest, RecordsStampedSlots) {
+  Dwell dwell(4);
+  dwell.on_push(2);
+  dwell.on_pop(2, 3);
+  dwell.on_push(0);
+  dwell.on_pop(0, 1);
+
+  const auto snapshot = dwell.snapshot();
+  EXPECT_EQ(snapshot.total, 2);
+  EXPECT_EQ(snapshot.high_water, 3);
+}
@@ -1,7 +1,12 @@
 #include <loon/lru.hpp>
 
+#include <cstdint>
 #include <gtest/gtest.h>
+#include <list>
+#include <random>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 class LRUTest : public ::testing::Test {
  protected:
@@ -105,3 +110,117 @@ TEST_F(LRUTest, UpdateExistingKey) {
   EXPECT_EQ(result->get(), "ONE");
   EXPECT_EQ(cache.size(), 1);
 }
+
+TEST_F(LRUTest, RemoveFreesCapacity) {
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  cache.remove(2);
+  EXPECT_EQ(cache.size(), 2);
+
+  cache.put(4, "four"); // Reuses the removed node, no eviction
+  EXPECT_TRUE(cache.exists(1));
+  EXPECT_TRUE(cache.exists(3));
+  EXPECT_TRUE(cache.exists(4));
+
+  cache.put(5, "five"); // Full again: evicts key 1
+  EXPECT_FALSE(cache.exists(1));
+  EXPECT_EQ(cache.size(), 3);
+}
+
+TEST_F(LRUTest, RemoveFrontAndBack) {
+  cache.put(1, "one");
+  cache.put(2, "two");
+  cache.put(3, "three");
+  cache.remove(3); // MRU
+  cache.remove(1); // LRU
+  cache.put(4, "four");
+  cache.put(5, "five");
+  cache.put(6, "six"); // Evicts key 2, the only survivor of the removals
+  EXPECT_FALSE(cache.exists(2));
+  EXPECT_EQ(cache.get(4)->get(), "four");
+}
+
+TEST(LRUCapacityTest, SingleEntry) {
+  loon::LRU<int, int> cache(1);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  EXPECT_FALSE(cache.exists(1));
+  EXPECT_EQ(cache.get(2)->get(), 20);
+  cache.remove(2);
+  EXPECT_EQ(cache.size(), 0);
+  cache.put(3, 30);
+  EXPECT_EQ(cache.get(3)->get(), 30);
+}
+
+// Keys that share low bits all land in the same probe run; removals must shift it back
+// without losing entries
+TEST(LRUIndexTest, CollidingKeysSurviveEviction) {
+  loon::LRU<uint64_t, uint64_t> cache(64);
+  for (uint64_t i = 0; i < 1000; ++i) {
+    cache.put(i << 20, i);
+    for (uint64_t j = (i >= 63 ? i - 63 : 0); j <= i; ++j) {
+      ASSERT_TRUE(cache.exists(j << 20)) << i << " " << j;
+    }
+  }
+}
+
+// Compares against a list-and-map model under random puts, gets and removes
+TEST(LRUIndexTest, MatchesReferenceModel) {
+  constexpr uint32_t capacity = 100;
+  loon::LRU<int, int> cache(capacity);
+  std::list<std::pair<int, int>> order; // MRU first
+  std::unordered_map<int, std::list<std::pair<int, int>>::iterator> model;
+  std::mt19937 rng(3);
+  std::uniform_int_distribution<int> key(0, 300);
+  std::uniform_int_distribution<int> op(0, 9);
+
+  for (int step = 0; step < 100000; ++step) {
+    const int k = key(rng);
+    const int kind = op(rng);
+    const auto it = model.find(k);
+    if (kind < 5) {
+      const auto value = cache.get(k);
+      ASSERT_EQ(value.has_value(), it != model.end());
+      if (value) {
+        EXPECT_EQ(value->get(), it->second->second);
+        order.splice(order.begin(), order, it->second);
+      }
+    } else if (kind < 9) {
+      cache.put(k, step);
+      if (it != model.end()) {
+        it->second->second = step;
+        order.splice(order.begin(), order, it->second);
+      } else {
+        if (order.size() == capacity) {
+          model.erase(order.back().first);
+          order.pop_back();
+        }
+        order.emplace_front(k, step);
+        model[k] = order.begin();
+      }
+    } else {
+      cache.remove(k);
+      if (it != model.end()) {
+        order.erase(it->second);
+        model.erase(it);
+      }
+    }
+    ASSERT_EQ(cache.size(), model.size());
+  }
+  for (int k = 0; k <= 300; ++k) {
+    EXPECT_EQ(cache.exists(k), model.count(k) == 1);
+  }
+}
+
+TEST(LRUIndexTest, StringKeys) {
+  loon::LRU<std::string, int> cache(128);
+  for (int i = 0; i < 1000; ++i) {
+    cache.put("key_" + std::to_string(i), i);
+  }
+  EXPECT_EQ(cache.size(), 128);
+  EXPECT_FALSE(cache.exists("key_871"));
+  for (int i = 872; i < 1000; ++i) {
+    ASSERT_EQ(cache.get("key_" + std::to_string(i))->get(), i);
+  }
+}
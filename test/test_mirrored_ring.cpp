@@ -0,0 +1,108 @@
+#include <loon/mirrored_ring.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <span>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+
+TEST(MirroredRingBufferTest, CapacityRoundedToPages) {
+  const auto page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+  loon::MirroredRingBuffer<std::byte> bytes(1);
+  EXPECT_EQ(bytes.capacity(), page);
+
+  loon::MirroredRingBuffer<uint64_t> words(page / 8 + 1);
+  EXPECT_EQ(words.capacity(), 2 * page / 8);
+
+  struct Odd {
+    char bytes[24];
+  };
+  loon::MirroredRingBuffer<Odd> odd(1);
+  EXPECT_EQ(odd.capacity() * sizeof(Odd) % page, 0);
+  EXPECT_GE(odd.capacity(), 1);
+}
+
+TEST(MirroredRingBufferTest, PushAndPop) {
+  loon::MirroredRingBuffer<int> buffer(1);
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_FALSE(buffer.pop().has_value());
+  EXPECT_FALSE(buffer.discard());
+
+  EXPECT_TRUE(buffer.push(1));
+  EXPECT_TRUE(buffer.push(2));
+  EXPECT_TRUE(buffer.push(3));
+  EXPECT_EQ(buffer.front(), 1);
+  EXPECT_EQ(buffer.back(), 3);
+  EXPECT_EQ(buffer.pop(), 1);
+  EXPECT_TRUE(buffer.discard());
+  EXPECT_EQ(buffer.size(), 1);
+}
+
+TEST(MirroredRingBufferTest, PushFull) {
+  loon::MirroredRingBuffer<int> buffer(1);
+  for (size_t i = 0; i < buffer.capacity(); ++i) {
+    EXPECT_TRUE(buffer.push(static_cast<int>(i)));
+  }
+  EXPECT_TRUE(buffer.full());
+  EXPECT_FALSE(buffer.push(-1));
+  EXPECT_TRUE(buffer.writable_span().empty());
+}
+
+TEST(MirroredRingBufferTest, SpansStayContiguousAcrossWrap) {
+  loon::MirroredRingBuffer<uint32_t> buffer(1);
+  const size_t capacity = buffer.capacity();
+  std::vector<uint32_t> values(capacity);
+  std::iota(values.begin(), values.end(), 0);
+
+  // Park the read index near the end, then fill the buffer so it straddles the wrap point
+  EXPECT_EQ(buffer.push_n(std::span(values).first(capacity - 3)), capacity - 3);
+  buffer.consume(capacity - 3);
+  auto free = buffer.writable_span();
+  ASSERT_EQ(free.size(), capacity);
+  std::copy(values.begin(), values.end(), free.begin());
+  buffer.produce(capacity);
+
+  auto readable = buffer.readable_span();
+  ASSERT_EQ(readable.size(), capacity);
+  for (size_t i = 0; i < capacity; ++i) {
+    EXPECT_EQ(readable[i], i);
+  }
+  // The slot after the wrap point is the same memory seen through the second mapping
+  EXPECT_EQ(&readable[3] - &readable[0], 3);
+
+  std::vector<uint32_t> out(capacity);
+  EXPECT_EQ(buffer.pop_n(out), capacity);
+  EXPECT_EQ(out, values);
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(MirroredRingBufferTest, BulkWrapAround) {
+  loon::MirroredRingBuffer<uint64_t> buffer(1);
+  std::array<uint64_t, 100> in{};
+  std::array<uint64_t, 100> out{};
+  uint64_t next = 0;
+  for (size_t lap = 0; lap < 3 * buffer.capacity() / in.size(); ++lap) {
+    for (auto& v : in) {
+      v = next++;
+    }
+    EXPECT_EQ(buffer.push_n(in), in.size());
+    EXPECT_EQ(buffer.pop_n(out), out.size());
+    EXPECT_EQ(out, in);
+  }
+}
+
+TEST(MirroredRingBufferTest, MoveTransfersMapping) {
+  loon::MirroredRingBuffer<int> buffer(1);
+  EXPECT_TRUE(buffer.push(7));
+  auto moved = std::move(buffer);
+  EXPECT_EQ(moved.pop(), 7);
+  EXPECT_EQ(buffer.capacity(), 0); // NOLINT(bugprone-use-after-move)
+}
+
+#endif // __linux__
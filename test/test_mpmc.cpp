@@ -0,0 +1,88 @@
+#include <loon/mpmc.hpp>
+
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class MpmcQueueTest : public ::testing::Test {
+ protected:
+  loon::MpmcQueue<int, 3> queue_buffer;
+};
+
+TEST_F(MpmcQueueTest, PopEmpty) {
+  int actual(-1);
+  ASSERT_TRUE(queue_buffer.empty());
+  ASSERT_FALSE(queue_buffer.pop(actual));
+}
+
+TEST_F(MpmcQueueTest, PushFull) {
+  ASSERT_TRUE(queue_buffer.push(1));
+  ASSERT_TRUE(queue_buffer.push(2));
+  ASSERT_TRUE(queue_buffer.push(3));
+  ASSERT_TRUE(queue_buffer.full());
+  ASSERT_EQ(queue_buffer.size(), 3);
+  ASSERT_FALSE(queue_buffer.push(4));
+}
+
+TEST_F(MpmcQueueTest, PushAndPop) {
+  int expected(1);
+  ASSERT_TRUE(queue_buffer.push(expected));
+  int actual(-1);
+  ASSERT_TRUE(queue_buffer.pop(actual));
+  ASSERT_EQ(expected, actual);
+}
+
+TEST_F(MpmcQueueTest, FifoAcrossWrapAround) {
+  for (int lap = 0; lap < 5; ++lap) {
+    ASSERT_TRUE(queue_buffer.push(lap * 10 + 1));
+    ASSERT_TRUE(queue_buffer.push(lap * 10 + 2));
+    int actual(-1);
+    ASSERT_TRUE(queue_buffer.pop(actual));
+    ASSERT_EQ(actual, lap * 10 + 1);
+    ASSERT_TRUE(queue_buffer.pop(actual));
+    ASSERT_EQ(actual, lap * 10 + 2);
+  }
+  ASSERT_TRUE(queue_buffer.empty());
+}
+
+TEST(MpmcQueueConcurrencyTest, EveryValueDeliveredOnce) {
+  constexpr int producers = 4;
+  constexpr int consumers = 4;
+  constexpr int per_producer = 5000;
+  loon::MpmcQueue<int, 64> queue;
+  std::vector<std::atomic<int>> seen(producers * per_producer);
+  std::atomic<int> consumed{0};
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < per_producer; ++i) {
+        while (!queue.push(p * per_producer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&] {
+      int value;
+      while (consumed.load() < producers * per_producer) {
+        if (queue.pop(value)) {
+          seen[value].fetch_add(1);
+          consumed.fetch_add(1);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& count : seen) {
+    ASSERT_EQ(count.load(), 1);
+  }
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,78 @@
+#include <loon/mpsc.hpp>
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+class MpscQueueTest : public ::testing::Test {
+ protected:
+  loon::MpscQueue<int, 3> queue_buffer;
+};
+
+TEST_F(MpscQueueTest, PopEmpty) {
+  int actual(-1);
+  ASSERT_TRUE(queue_buffer.empty());
+  ASSERT_FALSE(queue_buffer.pop(actual));
+}
+
+TEST_F(MpscQueueTest, PushFull) {
+  ASSERT_TRUE(queue_buffer.push(1));
+  ASSERT_TRUE(queue_buffer.push(2));
+  ASSERT_TRUE(queue_buffer.push(3));
+  ASSERT_FALSE(queue_buffer.push(4));
+}
+
+TEST_F(MpscQueueTest, PushAndPop) {
+  int expected(1);
+  ASSERT_TRUE(queue_buffer.push(expected));
+  ASSERT_FALSE(queue_buffer.empty());
+  int actual(-1);
+  ASSERT_TRUE(queue_buffer.pop(actual));
+  ASSERT_EQ(expected, actual);
+}
+
+TEST_F(MpscQueueTest, FifoAcrossWrapAround) {
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue_buffer.push(i));
+    ASSERT_TRUE(queue_buffer.push(i + 100));
+    int actual(-1);
+    ASSERT_TRUE(queue_buffer.pop(actual));
+    ASSERT_EQ(actual, i);
+    ASSERT_TRUE(queue_buffer.pop(actual));
+    ASSERT_EQ(actual, i + 100);
+  }
+}
+
+TEST(MpscQueueConcurrencyTest, PerProducerOrderPreserved) {
+  constexpr int producers = 4;
+  constexpr int per_producer = 5000;
+  loon::MpscQueue<int, 64> queue;
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      for (int i = 0; i < per_producer; ++i) {
+        while (!queue.push(p * per_producer + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  std::vector<int> next(producers, 0);
+  for (int received = 0; received < producers * per_producer;) {
+    int value;
+    if (!queue.pop(value)) {
+      std::this_thread::yield();
+      continue;
+    }
+    const int producer = value / per_producer;
+    ASSERT_EQ(value % per_producer, next[producer]);
+    ++next[producer];
+    ++received;
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,238 @@
+#include <loon/persistent_ring.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace {
+
+struct Event {
+  uint64_t id;
+  double price;
+  uint32_t qty;
+};
+
+using Journal = loon::PersistentRingBuffer<Event, 8>;
+
+// A journal path removed when the test ends
+class TempJournal {
+ public:
+  explicit TempJournal(const char* tag)
+      : path_((std::filesystem::temp_directory_path() /
+               ("loon_test_" + std::string(tag) + "_" + std::to_string(::getpid()) + ".ring"))
+                  .string()) {
+    std::filesystem::remove(path_);
+  }
+  ~TempJournal() { std::filesystem::remove(path_); }
+
+  const std::string& path() const { return path_; }
+
+ private:
+  std::string path_;
+};
+
+// Header bytes up to the read and write positions, matching the documented layout
+constexpr off_t READ_OFFSET = 32;
+
+} // namespace
+
+TEST(PersistentRingBufferTest, PushPopFrontBack) {
+  TempJournal file("basic");
+  Journal journal(file.path());
+  EXPECT_TRUE(journal.empty());
+  EXPECT_EQ(journal.recovered(), 0);
+  EXPECT_FALSE(journal.pop().has_value());
+
+  ASSERT_TRUE(journal.push({1, 10.5, 100}));
+  ASSERT_TRUE(journal.push({2, 11.5, 200}));
+  EXPECT_EQ(journal.size(), 2);
+  EXPECT_EQ(journal.front()->id, 1);
+  EXPECT_EQ(journal.back()->id, 2);
+
+  const auto first = journal.pop();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->price, 10.5);
+  EXPECT_TRUE(journal.discard());
+  EXPECT_FALSE(journal.discard());
+}
+
+TEST(PersistentRingBufferTest, RejectsWhenFull) {
+  TempJournal file("full");
+  Journal journal(file.path());
+  for (uint64_t i = 0; i < 8; ++i) {
+    ASSERT_TRUE(journal.push({i, 0, 0}));
+  }
+  EXPECT_TRUE(journal.full());
+  EXPECT_FALSE(journal.push({8, 0, 0}));
+}
+
+TEST(PersistentRingBufferTest, OverridesOldestWhenFull) {
+  TempJournal file("override");
+  Journal journal(file.path(), true);
+  EXPECT_TRUE(journal.overrides());
+  for (uint64_t i = 0; i < 20; ++i) {
+    ASSERT_TRUE(journal.push({i, 0, 0}));
+  }
+  EXPECT_EQ(journal.size(), 8);
+  EXPECT_EQ(journal.front()->id, 12);
+  EXPECT_EQ(journal.back()->id, 19);
+}
+
+TEST(PersistentRingBufferTest, ReopenRecoversElements) {
+  TempJournal file("reopen");
+  {
+    Journal journal(file.path(), true);
+    for (uint64_t i = 0; i < 13; ++i) {
+      ASSERT_TRUE(journal.push({i, static_cast<double>(i), 0}));
+    }
+    ASSERT_TRUE(journal.pop().has_value()); // 5..12 kept, then 5 popped
+  }
+  Journal journal(file.path(), true);
+  EXPECT_EQ(journal.recovered(), 7);
+  ASSERT_EQ(journal.size(), 7);
+  for (uint64_t i = 6; i < 13; ++i) {
+    const auto event = journal.pop();
+    ASSERT_TRUE(event.has_value());
+    EXPECT_EQ(event->id, i);
+    EXPECT_EQ(event->price, static_cast<double>(i));
+  }
+  EXPECT_TRUE(journal.empty());
+}
+
+TEST(PersistentRingBufferTest, RecoveryStopsAtCorruptRecord) {
+  TempJournal file("corrupt");
+  {
+    Journal journal(file.path());
+    for (uint64_t i = 0; i < 6; ++i) {
+      ASSERT_TRUE(journal.push({i, 0, 0}));
+    }
+  }
+  // Flip a byte in the value of record 3, as a torn write would leave it
+  const auto page = static_cast<off_t>(::sysconf(_SC_PAGESIZE));
+  const off_t record_size = 16 + sizeof(Event);
+  const int fd = ::open(file.path().c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  const char garbage = 0x5a;
+  ASSERT_EQ(::pwrite(fd, &garbage, 1, page + 3 * record_size + 20), 1);
+  ::close(fd);
+
+  Journal journal(file.path());
+  EXPECT_EQ(journal.recovered(), 3);
+  EXPECT_EQ(journal.back()->id, 2);
+  ASSERT_TRUE(journal.push({100, 0, 0})); // appends after the last valid record
+  EXPECT_EQ(journal.back()->id, 100);
+}
+
+TEST(PersistentRingBufferTest, RecoveryUsesSavedReadPosition) {
+  TempJournal file("position");
+  {
+    Journal journal(file.path());
+    for (uint64_t i = 0; i < 5; ++i) {
+      ASSERT_TRUE(journal.push({i, 0, 0}));
+    }
+  }
+  // Pretend the read position was written back as 2
+  const int fd = ::open(file.path().c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  const uint64_t read = 2;
+  ASSERT_EQ(::pwrite(fd, &read, sizeof(read), READ_OFFSET), static_cast<ssize_t>(sizeof(read)));
+  ::close(fd);
+
+  Journal journal(file.path());
+  EXPECT_EQ(journal.recovered(), 3);
+  EXPECT_EQ(journal.front()->id, 2);
+}
+
+TEST(PersistentRingBufferTest, RecoveryIgnoresStaleReadPosition) {
+  TempJournal file("stale");
+  {
+    Journal journal(file.path(), true);
+    for (uint64_t i = 0; i < 20; ++i) {
+      ASSERT_TRUE(journal.push({i, 0, 0}));
+    }
+  }
+  // Pretend the read position reached the disk before the overriding pushes advanced it
+  const int fd = ::open(file.path().c_str(), O_RDWR);
+  ASSERT_GE(fd, 0);
+  const uint64_t read = 4;
+  ASSERT_EQ(::pwrite(fd, &read, sizeof(read), READ_OFFSET), static_cast<ssize_t>(sizeof(read)));
+  ::close(fd);
+
+  Journal journal(file.path(), true);
+  EXPECT_EQ(journal.recovered(), 8);
+  EXPECT_EQ(journal.front()->id, 12);
+  EXPECT_EQ(journal.back()->id, 19);
+}
+
+// T only needs to be trivially copyable, not default constructible
+TEST(PersistentRingBufferTest, NonDefaultConstructibleElements) {
+  struct Tick {
+    explicit Tick(uint64_t value) : id(value) {}
+    uint64_t id;
+  };
+  TempJournal file("tick");
+  loon::PersistentRingBuffer<Tick, 4> journal(file.path());
+  ASSERT_TRUE(journal.push(Tick(7)));
+  EXPECT_EQ(journal.front()->id, 7);
+  EXPECT_EQ(journal.pop()->id, 7);
+}
+
+TEST(PersistentRingBufferTest, SurvivesProcessCrash) {
+  TempJournal file("crash");
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    Journal journal(file.path());
+    for (uint64_t i = 0; i < 4; ++i) {
+      (void)journal.push({i, 0, 0});
+    }
+    ::_exit(0); // no destructor, no msync
+  }
+  int status = 0;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+
+  Journal journal(file.path());
+  EXPECT_EQ(journal.recovered(), 4);
+  EXPECT_EQ(journal.back()->id, 3);
+}
+
+TEST(PersistentRingBufferTest, FlushPolicies) {
+  TempJournal file("flush");
+  Journal journal(file.path(), true, 3);
+  for (uint64_t i = 0; i < 20; ++i) {
+    ASSERT_TRUE(journal.push({i, 0, 0}));
+  }
+  journal.flush();
+  ASSERT_TRUE(journal.pop().has_value());
+  journal.flush();
+}
+
+TEST(PersistentRingBufferTest, MismatchedLayoutThrows) {
+  TempJournal file("mismatch");
+  { Journal journal(file.path()); }
+  using Larger = loon::PersistentRingBuffer<Event, 16>;
+  EXPECT_THROW(Larger journal(file.path()), std::runtime_error);
+  using Other = loon::PersistentRingBuffer<uint64_t, 8>;
+  EXPECT_THROW(Other journal(file.path()), std::runtime_error);
+}
+
+TEST(PersistentRingBufferTest, ForeignFileThrows) {
+  TempJournal file("foreign");
+  std::FILE* out = std::fopen(file.path().c_str(), "w");
+  ASSERT_NE(out, nullptr);
+  std::fputs("not a journal, just some text that is long enough for a header", out);
+  std::fclose(out);
+  EXPECT_THROW(Journal journal(file.path()), std::runtime_error);
+}
+
+TEST(PersistentRingBufferTest, MissingDirectoryThrows) {
+  EXPECT_THROW(Journal journal("/nonexistent/loon/journal.ring"), std::system_error);
+}
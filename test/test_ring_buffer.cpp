@@ -1,6 +1,16 @@
 #include <loon/ring_buffer.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <gtest/gtest.h>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 class RingBufferTest : public ::testing::Test {
  protected:
@@ -79,4 +89,305 @@ TEST_F(RingBufferTest, OverridePush) {
   EXPECT_TRUE(override_buffer.push(100)); // should succeed, overriding oldest
   EXPECT_TRUE(override_buffer.full());
   EXPECT_EQ(override_buffer.size(), 5);
-}
\ No newline at end of file
+}
+
+TEST_F(RingBufferTest, WrapAround) {
+  for (int i = 0; i < 25; ++i) {
+    EXPECT_TRUE(buffer.push(i));
+    EXPECT_EQ(buffer.back().value(), i);
+    EXPECT_EQ(buffer.pop().value(), i);
+  }
+  EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferMaskTest, PowerOfTwoWrapAround) {
+  loon::RingBuffer<int, 4> ring(true);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(ring.push(i));
+    EXPECT_EQ(ring.back().value(), i);
+  }
+  EXPECT_EQ(ring.size(), 4);
+  for (int i = 6; i < 10; ++i) {
+    EXPECT_EQ(ring.pop().value(), i);
+  }
+}
+
+TEST(RingBufferInstrumentTest, RecordsDwellAndHighWater) {
+  loon::RingBuffer<int, 4, loon::DwellInstrumentation> ring;
+  EXPECT_TRUE(ring.push(1));
+  EXPECT_TRUE(ring.push(2));
+  EXPECT_TRUE(ring.push(3));
+  EXPECT_EQ(ring.pop().value(), 1);
+  EXPECT_TRUE(ring.discard());
+
+  auto stats = ring.instrumentation().snapshot();
+  EXPECT_EQ(stats.total, 2);
+  EXPECT_EQ(stats.high_water, 3);
+
+  ring.instrumentation().reset();
+  EXPECT_EQ(ring.pop().value(), 3);
+  stats = ring.instrumentation().snapshot();
+  EXPECT_EQ(stats.total, 1);
+  EXPECT_EQ(stats.high_water, 1);
+}
+
+TEST(RingBufferInstrumentTest, DisabledPolicyAddsNoStorage) {
+  // Same layout as RingBuffer<int, 8> without an instrumentation member
+  struct Replica {
+    alignas(int) std::byte buffer[8 * sizeof(int)];
+    size_t write;
+    size_t read;
+    size_t count;
+    bool override;
+  };
+  EXPECT_EQ(sizeof(loon::RingBuffer<int, 8>), sizeof(Replica));
+}
+
+// Counts live instances so tests can check every constructed element is destroyed once
+struct Tracked {
+  static inline int live = 0;
+
+  explicit Tracked(int v) : value(v) { ++live; }
+  Tracked(const Tracked& other) : value(other.value) { ++live; }
+  Tracked(Tracked&& other) noexcept : value(other.value) { ++live; }
+  Tracked& operator=(const Tracked&) = default;
+  ~Tracked() { --live; }
+
+  int value;
+};
+
+TEST(RingBufferStorageTest, MoveOnlyElements) {
+  loon::RingBuffer<std::unique_ptr<int>, 2> buffer;
+  auto value = std::make_unique<int>(1);
+  EXPECT_TRUE(buffer.push(std::move(value)));
+  EXPECT_EQ(value, nullptr);
+  EXPECT_TRUE(buffer.emplace(new int(2)));
+  auto rejected = std::make_unique<int>(3);
+  EXPECT_FALSE(buffer.push(std::move(rejected)));
+  EXPECT_NE(rejected, nullptr);
+
+  auto popped = buffer.pop();
+  ASSERT_TRUE(popped.has_value());
+  EXPECT_EQ(**popped, 1);
+}
+
+TEST(RingBufferStorageTest, OverrideDestroysOldest) {
+  Tracked::live = 0;
+  {
+    loon::RingBuffer<Tracked, 3> buffer(true);
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_TRUE(buffer.emplace(i));
+      EXPECT_LE(Tracked::live, 3);
+    }
+    EXPECT_EQ(Tracked::live, 3);
+    EXPECT_EQ(buffer.front()->value, 7);
+    EXPECT_TRUE(buffer.discard());
+    EXPECT_EQ(Tracked::live, 2);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+// Pushing an element of the buffer itself must not read the slot it is about to replace
+TEST(RingBufferStorageTest, OverridePushAliasingOldest) {
+  loon::RingBuffer<std::string, 2> buffer(true);
+  const std::string first(40, 'x');
+  EXPECT_TRUE(buffer.push(first));
+  EXPECT_TRUE(buffer.push(std::string(40, 'y')));
+
+  EXPECT_TRUE(buffer.push(buffer[0]));
+  EXPECT_EQ(buffer.size(), 2);
+  EXPECT_EQ(buffer[0], std::string(40, 'y'));
+  EXPECT_EQ(buffer[1], first);
+
+  EXPECT_TRUE(buffer.emplace(std::move(buffer[0])));
+  EXPECT_EQ(buffer[0], first);
+  EXPECT_EQ(buffer[1], std::string(40, 'y'));
+}
+
+TEST(RingBufferStorageTest, CopyAndMove) {
+  loon::RingBuffer<std::string, 3> buffer(true);
+  for (const char* s : {"a", "b", "c", "d"}) {
+    EXPECT_TRUE(buffer.push(std::string(s)));
+  }
+
+  auto copy = buffer;
+  EXPECT_TRUE(copy.overrides());
+  EXPECT_EQ(copy.size(), 3);
+  EXPECT_EQ(*copy.pop(), "b");
+  EXPECT_EQ(buffer.size(), 3);
+
+  auto moved = std::move(buffer);
+  EXPECT_EQ(moved.size(), 3);
+  EXPECT_EQ(*moved.back(), "d");
+  EXPECT_TRUE(buffer.empty()); // NOLINT(bugprone-use-after-move)
+
+  copy = moved;
+  EXPECT_EQ(*copy.front(), "b");
+  EXPECT_EQ(copy.size(), 3);
+}
+
+TEST(RingBufferBulkTest, SpansCoverWrapPoint) {
+  loon::RingBuffer<int, 8> buffer;
+  const std::array<int, 6> values{0, 1, 2, 3, 4, 5};
+  EXPECT_EQ(buffer.push_n(values), 6);
+  buffer.consume(4);
+  EXPECT_EQ(buffer.push_n(values), 6); // occupies slots 6..7 and 0..3
+
+  auto [first, second] = buffer.readable_spans();
+  EXPECT_EQ(first.size(), 4);
+  EXPECT_EQ(second.size(), 4);
+  EXPECT_EQ(first[0], 4);
+  EXPECT_EQ(first[2], 0);
+  EXPECT_EQ(second[3], 5);
+
+  auto [free_first, free_second] = buffer.writable_spans();
+  EXPECT_EQ(free_first.size(), 0);
+  EXPECT_EQ(free_second.size(), 0);
+
+  buffer.consume(3);
+  auto [tail, head] = buffer.writable_spans();
+  EXPECT_EQ(tail.size(), 3); // slots 4..6; slot 7 is still live
+  EXPECT_EQ(head.size(), 0);
+  tail[0] = 42;
+  buffer.produce(1);
+  EXPECT_EQ(buffer.size(), 6);
+  EXPECT_EQ(buffer.back(), 42);
+}
+
+TEST(RingBufferBulkTest, PushNPopNWrapAround) {
+  loon::RingBuffer<int, 5> buffer;
+  std::array<int, 4> in{};
+  std::array<int, 4> out{};
+  int next = 0;
+  for (int lap = 0; lap < 7; ++lap) {
+    for (auto& v : in) {
+      v = next++;
+    }
+    EXPECT_EQ(buffer.push_n(in), 4);
+    EXPECT_EQ(buffer.pop_n(out), 4);
+    EXPECT_EQ(out, in);
+  }
+  EXPECT_TRUE(buffer.empty());
+  EXPECT_EQ(buffer.pop_n(out), 0);
+}
+
+TEST(RingBufferBulkTest, PushNRejectsOverflow) {
+  loon::RingBuffer<int, 4> buffer;
+  const std::array<int, 6> values{1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(buffer.push_n(values), 4);
+  EXPECT_EQ(buffer.push_n(values), 0);
+  EXPECT_EQ(buffer.front(), 1);
+  EXPECT_EQ(buffer.back(), 4);
+}
+
+TEST(RingBufferBulkTest, PushNOverridesOldest) {
+  loon::RingBuffer<int, 4> buffer(true);
+  EXPECT_TRUE(buffer.push(100));
+  EXPECT_TRUE(buffer.push(101));
+  const std::array<int, 3> few{1, 2, 3};
+  EXPECT_EQ(buffer.push_n(few), 3);
+  EXPECT_EQ(buffer.front(), 101);
+
+  const std::array<int, 6> many{4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(buffer.push_n(many), 6);
+  std::array<int, 4> out{};
+  EXPECT_EQ(buffer.pop_n(out), 4);
+  EXPECT_EQ(out, (std::array<int, 4>{6, 7, 8, 9}));
+}
+
+// Pushing the buffer's own elements must not read slots that are dropped to make room
+TEST(RingBufferBulkTest, PushNOwnSpanInOverrideMode) {
+  loon::RingBuffer<std::string, 3> strings(true);
+  for (const char* s : {"a", "b", "c"}) {
+    EXPECT_TRUE(strings.push(std::string(40, *s)));
+  }
+  EXPECT_EQ(strings.push_n(strings.readable_spans()[0]), 3);
+  EXPECT_EQ(strings.size(), 3);
+  EXPECT_EQ(strings[0], std::string(40, 'a'));
+  EXPECT_EQ(strings[1], std::string(40, 'b'));
+  EXPECT_EQ(strings[2], std::string(40, 'c'));
+
+  loon::RingBuffer<int, 4> ints(true);
+  for (int i = 0; i < 6; ++i) {
+    EXPECT_TRUE(ints.push(i)); // wraps: 2, 3 | 4, 5
+  }
+  const auto spans = ints.readable_spans();
+  ASSERT_EQ(spans[0].size(), 2);
+  EXPECT_EQ(ints.push_n(spans[0]), 2); // drops 2, 3 and writes them back into their slots
+  std::array<int, 4> out{};
+  EXPECT_EQ(ints.pop_n(out), 4);
+  EXPECT_EQ(out, (std::array<int, 4>{4, 5, 2, 3}));
+}
+
+TEST(RingBufferBulkTest, NonTrivialElements) {
+  Tracked::live = 0;
+  {
+    loon::RingBuffer<std::string, 4> buffer(true);
+    const std::array<std::string, 3> values{std::string(40, 'a'), std::string(40, 'b'), "c"};
+    EXPECT_EQ(buffer.push_n(values), 3);
+    EXPECT_EQ(buffer.push_n(values), 3); // drops the two oldest
+    EXPECT_EQ(*buffer.front(), values[2]);
+
+    const auto [first, second] = std::as_const(buffer).readable_spans();
+    EXPECT_EQ(first.size() + second.size(), 4);
+    buffer.consume(1);
+
+    std::array<std::string, 4> out;
+    EXPECT_EQ(buffer.pop_n(out), 3);
+    EXPECT_EQ(out[2], "c");
+    EXPECT_TRUE(buffer.empty());
+
+    loon::RingBuffer<Tracked, 3> tracked;
+    const std::array<Tracked, 2> items{Tracked(1), Tracked(2)};
+    EXPECT_EQ(tracked.push_n(items), 2);
+    tracked.consume(2);
+    EXPECT_EQ(Tracked::live, 2); // only the source array remains
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+static_assert(std::ranges::random_access_range<loon::RingBuffer<int, 8>>);
+static_assert(std::ranges::random_access_range<const loon::RingBuffer<int, 8>>);
+static_assert(std::ranges::sized_range<loon::RingBuffer<int, 8>>);
+
+TEST(RingBufferIteratorTest, LogicalOrderAcrossWrap) {
+  loon::RingBuffer<int, 5> buffer(true);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE(buffer.push(i)); // holds 3..7, starting mid-storage
+  }
+  EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int>{3, 4, 5, 6, 7}));
+  EXPECT_EQ(buffer.end() - buffer.begin(), 5);
+  EXPECT_EQ(buffer[0], 3);
+  EXPECT_EQ(buffer[4], 7);
+  EXPECT_EQ(buffer.begin()[2], 5);
+  EXPECT_EQ(*(buffer.end() - 1), 7);
+  EXPECT_EQ(std::accumulate(buffer.cbegin(), buffer.cend(), 0), 25);
+}
+
+TEST(RingBufferIteratorTest, AtChecksBounds) {
+  loon::RingBuffer<int, 4> buffer;
+  EXPECT_THROW((void)buffer.at(0), std::out_of_range);
+  EXPECT_TRUE(buffer.push(1));
+  EXPECT_TRUE(buffer.push(2));
+  EXPECT_EQ(buffer.at(1), 2);
+  EXPECT_THROW((void)std::as_const(buffer).at(2), std::out_of_range);
+}
+
+TEST(RingBufferIteratorTest, RangesAlgorithmsInPlace) {
+  loon::RingBuffer<int, 6> buffer(true);
+  for (int v : {9, 1, 8, 2, 7, 3, 6, 4}) {
+    EXPECT_TRUE(buffer.push(v));
+  }
+  auto found = std::ranges::find(buffer, 7);
+  ASSERT_NE(found, buffer.end());
+  EXPECT_EQ(found - buffer.begin(), 2);
+
+  std::ranges::sort(buffer); // mutable iterators write through to the slots
+  EXPECT_TRUE(std::ranges::is_sorted(buffer));
+  EXPECT_EQ(buffer.front(), 2);
+  EXPECT_EQ(buffer.pop(), 2);
+
+  buffer[0] = 42;
+  loon::RingBuffer<int, 6>::const_iterator first = buffer.begin();
+  EXPECT_EQ(*first, 42);
+}
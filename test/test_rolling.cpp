@@ -0,0 +1,116 @@
+#include <loon/rolling.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <random>
+
+// Recomputes every statistic from a copy of the window, the way the adapter replaces
+struct Naive {
+  std::deque<double> values;
+  size_t length;
+
+  void push(double x) {
+    values.push_back(x);
+    if (values.size() > length)
+      values.pop_front();
+  }
+  double sum() const { return std::accumulate(values.begin(), values.end(), 0.0); }
+  double mean() const { return sum() / static_cast<double>(values.size()); }
+  double variance() const {
+    const double m = mean();
+    double m2 = 0;
+    for (double v : values) {
+      m2 += (v - m) * (v - m);
+    }
+    return m2 / static_cast<double>(values.size());
+  }
+};
+
+TEST(RollingWindowTest, EmptyWindow) {
+  loon::RollingWindow<double, 8> window;
+  EXPECT_TRUE(window.empty());
+  EXPECT_EQ(window.sum(), 0.0);
+  EXPECT_EQ(window.mean(), 0.0);
+  EXPECT_EQ(window.variance(), 0.0);
+  EXPECT_EQ(window.sample_variance(), 0.0);
+}
+
+TEST(RollingWindowTest, MatchesNaiveRecompute) {
+  constexpr size_t LENGTH = 37;
+  loon::RollingWindow<double, LENGTH> window;
+  Naive naive{{}, LENGTH};
+  std::mt19937 rng(7);
+  std::normal_distribution<double> price(100.0, 5.0);
+
+  for (int i = 0; i < 1000; ++i) {
+    const double x = price(rng);
+    window.push(x);
+    naive.push(x);
+    ASSERT_EQ(window.size(), naive.values.size());
+    EXPECT_NEAR(window.sum(), naive.sum(), 1e-9);
+    EXPECT_NEAR(window.mean(), naive.mean(), 1e-9);
+    EXPECT_NEAR(window.variance(), naive.variance(), 1e-7);
+    EXPECT_EQ(window.min(), *std::ranges::min_element(naive.values));
+    EXPECT_EQ(window.max(), *std::ranges::max_element(naive.values));
+  }
+  EXPECT_TRUE(window.full());
+}
+
+TEST(RollingWindowTest, MinMaxMonotonicRuns) {
+  loon::RollingWindow<int64_t, 3> window;
+  for (int64_t v : {5, 4, 3, 2, 1}) {
+    window.push(v); // falling run: max must expire each step
+  }
+  EXPECT_EQ(window.max(), 3);
+  EXPECT_EQ(window.min(), 1);
+  for (int64_t v : {2, 3, 4}) {
+    window.push(v); // rising run: min must expire each step
+  }
+  EXPECT_EQ(window.min(), 2);
+  EXPECT_EQ(window.max(), 4);
+  window.push(4); // duplicates of the extreme
+  window.push(4);
+  EXPECT_EQ(window.min(), 4);
+  EXPECT_EQ(window.max(), 4);
+  EXPECT_NEAR(window.variance(), 0.0, 1e-12);
+}
+
+TEST(RollingWindowTest, RecomputeBoundsDrift) {
+  // Large offset and small spread: the running sums lose precision over many updates
+  loon::RollingWindow<double, 64> drifting;
+  loon::RollingWindow<double, 64> refreshed(1024);
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<double> noise(-0.5, 0.5);
+  for (int i = 0; i < 200000; ++i) {
+    const double x = 1e9 + noise(rng);
+    drifting.push(x);
+    refreshed.push(x);
+  }
+
+  Naive naive{{}, 64};
+  for (double v : refreshed.values()) {
+    naive.push(v);
+  }
+  const double exact = naive.variance();
+  EXPECT_NEAR(refreshed.variance(), exact, 1e-3);
+  drifting.recompute();
+  EXPECT_NEAR(drifting.variance(), exact, 1e-3);
+  EXPECT_NEAR(drifting.mean(), naive.mean(), 1e-6);
+}
+
+TEST(RollingWindowTest, ClearResets) {
+  loon::RollingWindow<int, 4> window;
+  for (int v : {1, 2, 3, 4, 5}) {
+    window.push(v);
+  }
+  window.clear();
+  EXPECT_TRUE(window.empty());
+  window.push(10);
+  EXPECT_EQ(window.min(), 10);
+  EXPECT_EQ(window.max(), 10);
+  EXPECT_DOUBLE_EQ(window.mean(), 10.0);
+}
@@ -0,0 +1,92 @@
+#include <loon/seqlock.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+struct Quote {
+  int64_t bid;
+  int64_t ask;
+  int64_t bid_size;
+  int64_t ask_size;
+};
+
+TEST(SeqlockTest, DefaultValue) {
+  loon::Seqlock<int> slot;
+  EXPECT_EQ(slot.load(), 0);
+  EXPECT_EQ(slot.version(), 0);
+
+  loon::Seqlock<int> initialized(42);
+  EXPECT_EQ(initialized.load(), 42);
+}
+
+TEST(SeqlockTest, StoreReplacesValue) {
+  loon::Seqlock<Quote> slot;
+  slot.store({100, 101, 5, 7});
+  slot.store({102, 103, 1, 2});
+
+  const auto quote = slot.load();
+  EXPECT_EQ(quote.bid, 102);
+  EXPECT_EQ(quote.ask, 103);
+  EXPECT_EQ(quote.bid_size, 1);
+  EXPECT_EQ(quote.ask_size, 2);
+}
+
+TEST(SeqlockTest, VersionCountsStores) {
+  loon::Seqlock<int> slot;
+  for (int i = 1; i <= 3; ++i) {
+    slot.store(i);
+    EXPECT_EQ(slot.version(), static_cast<size_t>(i));
+  }
+}
+
+TEST(SeqlockTest, TryLoadWithoutWriter) {
+  loon::Seqlock<int> slot;
+  slot.store(7);
+  int actual(-1);
+  ASSERT_TRUE(slot.try_load(actual));
+  EXPECT_EQ(actual, 7);
+}
+
+// Every stored value has all fields equal, so a torn read shows up as mismatched fields
+TEST(SeqlockTest, ReadersNeverSeeTornValues) {
+  using Block = std::array<int64_t, 16>;
+  loon::Seqlock<Block> slot;
+  constexpr int64_t count = 100000;
+  std::atomic<bool> done{false};
+  std::atomic<int> torn{0};
+
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      int64_t last = 0;
+      while (!done.load(std::memory_order_relaxed)) {
+        const auto block = slot.load();
+        for (const auto field : block) {
+          if (field != block[0])
+            torn.fetch_add(1, std::memory_order_relaxed);
+        }
+        if (block[0] < last)
+          torn.fetch_add(1, std::memory_order_relaxed); // Values only move forward
+        last = block[0];
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  Block block{};
+  for (int64_t i = 1; i <= count; ++i) {
+    block.fill(i);
+    slot.store(block);
+  }
+  done.store(true, std::memory_order_relaxed);
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_EQ(torn.load(), 0);
+  EXPECT_EQ(slot.load()[0], count);
+}
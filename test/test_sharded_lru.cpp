@@ -0,0 +1,115 @@
+#include <loon/sharded_lru.hpp>
+#include <loon/wait.hpp>
+
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename Lock>
+class ShardedLRUTest : public ::testing::Test {
+ protected:
+  loon::ShardedLRU<int, std::string, Lock> cache{64, 4};
+};
+
+using ShardLocks = ::testing::Types<std::mutex, loon::SpinLock<>>;
+TYPED_TEST_SUITE(ShardedLRUTest, ShardLocks);
+
+TYPED_TEST(ShardedLRUTest, PutAndGet) {
+  this->cache.put(1, "one");
+  auto result = this->cache.get(1);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, "one");
+  EXPECT_FALSE(this->cache.get(2).has_value());
+}
+
+TYPED_TEST(ShardedLRUTest, ExistsAndRemove) {
+  this->cache.put(1, "one");
+  EXPECT_TRUE(this->cache.exists(1));
+  EXPECT_FALSE(this->cache.exists(2));
+  this->cache.remove(1);
+  this->cache.remove(2);
+  EXPECT_FALSE(this->cache.exists(1));
+  EXPECT_EQ(this->cache.size(), 0);
+}
+
+TYPED_TEST(ShardedLRUTest, UpdateExistingKey) {
+  this->cache.put(1, "one");
+  this->cache.put(1, "ONE");
+  EXPECT_EQ(*this->cache.get(1), "ONE");
+  EXPECT_EQ(this->cache.size(), 1);
+}
+
+TYPED_TEST(ShardedLRUTest, SizeSumsShards) {
+  for (int i = 0; i < 40; ++i) {
+    this->cache.put(i, std::to_string(i));
+  }
+  EXPECT_EQ(this->cache.shard_count(), 4);
+  EXPECT_EQ(this->cache.capacity(), 64);
+  EXPECT_LE(this->cache.size(), 40);
+  EXPECT_GT(this->cache.size(), 16); // Some shard may fill and evict, but not most keys
+}
+
+TYPED_TEST(ShardedLRUTest, NeverExceedsCapacity) {
+  for (int i = 0; i < 10000; ++i) {
+    this->cache.put(i, std::to_string(i));
+  }
+  EXPECT_EQ(this->cache.size(), this->cache.capacity());
+  EXPECT_TRUE(this->cache.exists(9999)); // The newest key is never evicted
+}
+
+TEST(ShardedLRUShapeTest, RoundsShardCount) {
+  loon::ShardedLRU<int, int> cache(1000, 12);
+  EXPECT_EQ(cache.shard_count(), 16);
+  EXPECT_EQ(cache.capacity(), 16 * 63);
+}
+
+TEST(ShardedLRUShapeTest, NoMoreShardsThanEntries) {
+  loon::ShardedLRU<int, int> cache(3, 16);
+  EXPECT_EQ(cache.shard_count(), 2);
+  EXPECT_EQ(cache.capacity(), 4);
+}
+
+TEST(ShardedLRUShapeTest, SingleShardIsExactLRU) {
+  loon::ShardedLRU<int, int> cache(3, 1);
+  cache.put(1, 10);
+  cache.put(2, 20);
+  cache.put(3, 30);
+  cache.get(1);
+  cache.put(4, 40); // Evicts key 2
+  EXPECT_TRUE(cache.exists(1));
+  EXPECT_FALSE(cache.exists(2));
+  EXPECT_TRUE(cache.exists(3));
+  EXPECT_TRUE(cache.exists(4));
+}
+
+// Threads hammer overlapping keys; every value read back must be one some thread wrote
+template <typename Lock>
+static void run_concurrent(int threads) {
+  loon::ShardedLRU<uint64_t, uint64_t, Lock> cache(512, 8);
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    workers.emplace_back([&cache, t] {
+      for (uint64_t i = 0; i < 20000; ++i) {
+        const uint64_t key = (i * 7 + static_cast<uint64_t>(t)) % 2048;
+        if (auto value = cache.get(key)) {
+          ASSERT_EQ(*value, key * 3);
+        } else {
+          cache.put(key, key * 3);
+        }
+        if (i % 64 == 0)
+          cache.remove(key);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  EXPECT_LE(cache.size(), cache.capacity());
+}
+
+TEST(ShardedLRUConcurrencyTest, MutexShards) { run_concurrent<std::mutex>(8); }
+
+TEST(ShardedLRUConcurrencyTest, SpinLockShards) { run_concurrent<loon::SpinLock<>>(8); }
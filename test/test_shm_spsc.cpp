@@ -0,0 +1,94 @@
+#include <loon/shm_spsc.hpp>
+
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <sys/wait.h>
+#include <system_error>
+#include <unistd.h>
+
+namespace {
+
+using IntQueue8 = loon::ShmSpscQueue<int, 8>;
+using IntQueue16 = loon::ShmSpscQueue<int, 16>;
+
+std::string unique_name(const char* tag) {
+  return "/loon_test_" + std::string(tag) + "_" + std::to_string(::getpid());
+}
+
+} // namespace
+
+TEST(ShmSpscQueueTest, CreateAndAttachByName) {
+  const auto name = unique_name("named");
+  auto producer = IntQueue8::create(name);
+  auto consumer = IntQueue8::attach(name);
+
+  ASSERT_TRUE(consumer.queue().empty());
+  ASSERT_TRUE(producer.queue().push(42));
+  int actual(-1);
+  ASSERT_TRUE(consumer.queue().pop(actual));
+  EXPECT_EQ(actual, 42);
+  EXPECT_TRUE(producer.queue().empty());
+}
+
+TEST(ShmSpscQueueTest, CreateExistingNameFails) {
+  const auto name = unique_name("exists");
+  auto first = IntQueue8::create(name);
+  EXPECT_THROW(IntQueue8::create(name), std::system_error);
+}
+
+TEST(ShmSpscQueueTest, AttachMissingNameFails) {
+  EXPECT_THROW(IntQueue8::attach(unique_name("missing")), std::system_error);
+}
+
+TEST(ShmSpscQueueTest, NameUnlinkedWithCreator) {
+  const auto name = unique_name("unlink");
+  { auto shm = IntQueue8::create(name); }
+  EXPECT_THROW(IntQueue8::attach(name), std::system_error);
+}
+
+TEST(ShmSpscQueueTest, AttachLayoutMismatch) {
+  const auto name = unique_name("mismatch");
+  auto shm = IntQueue16::create(name);
+  EXPECT_THROW(IntQueue8::attach(name), std::runtime_error);
+  using Int64Queue16 = loon::ShmSpscQueue<int64_t, 16>;
+  EXPECT_THROW(Int64Queue16::attach(name), std::runtime_error);
+}
+
+#ifdef __linux__
+TEST(ShmSpscQueueTest, AnonymousAttachByFd) {
+  auto producer = IntQueue8::create_anonymous();
+  auto consumer = IntQueue8::attach(producer.fd());
+
+  ASSERT_TRUE(producer.queue().push(7));
+  int actual(-1);
+  ASSERT_TRUE(consumer.queue().pop(actual));
+  EXPECT_EQ(actual, 7);
+}
+
+TEST(ShmSpscQueueTest, CrossProcess) {
+  auto shm = IntQueue16::create_anonymous();
+  constexpr int count = 1000;
+
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (child == 0) {
+    // Child process is the producer
+    for (int i = 0; i < count; ++i) {
+      while (!shm.queue().push(i)) {
+      }
+    }
+    ::_exit(0);
+  }
+
+  for (int i = 0; i < count; ++i) {
+    int actual(-1);
+    while (!shm.queue().pop(actual)) {
+    }
+    ASSERT_EQ(actual, i);
+  }
+  int status = 0;
+  ::waitpid(child, &status, 0);
+  EXPECT_TRUE(WIFEXITED(status));
+}
+#endif
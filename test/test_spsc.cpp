@@ -1,6 +1,14 @@
 #include <loon/spsc.hpp>
 
+#include <array>
+#include <atomic>
 #include <gtest/gtest.h>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
 
 class SpscQueueTest : public ::testing::Test {
  protected:
@@ -27,4 +35,302 @@ TEST_F(SpscQueueTest, PushAndPop) {
   int actual(-1);
   ASSERT_TRUE(queue_buffer.pop(actual));
   ASSERT_EQ(expected, actual);
-}
\ No newline at end of file
+}
+
+TEST_F(SpscQueueTest, PushNPartial) {
+  const std::array<int, 5> values{1, 2, 3, 4, 5};
+  ASSERT_EQ(queue_buffer.push_n(values), 3);
+  ASSERT_TRUE(queue_buffer.full());
+  ASSERT_EQ(queue_buffer.push_n(values), 0);
+}
+
+TEST_F(SpscQueueTest, PopNEmpty) {
+  std::array<int, 3> out{};
+  ASSERT_EQ(queue_buffer.pop_n(std::span<int>(out)), 0);
+}
+
+TEST_F(SpscQueueTest, PushNPopNWrapAround) {
+  ASSERT_TRUE(queue_buffer.push(1));
+  ASSERT_TRUE(queue_buffer.push(2));
+  int actual(-1);
+  ASSERT_TRUE(queue_buffer.pop(actual));
+  ASSERT_TRUE(queue_buffer.pop(actual));
+
+  // write index is now at slot 2, so the batch wraps to slot 0
+  const std::array<int, 3> values{10, 20, 30};
+  ASSERT_EQ(queue_buffer.push_n(values), 3);
+
+  std::array<int, 4> out{};
+  ASSERT_EQ(queue_buffer.pop_n(std::span<int>(out)), 3);
+  ASSERT_EQ(out[0], 10);
+  ASSERT_EQ(out[1], 20);
+  ASSERT_EQ(out[2], 30);
+  ASSERT_TRUE(queue_buffer.empty());
+}
+
+TEST_F(SpscQueueTest, PopNOutputIterator) {
+  const std::array<int, 3> values{1, 2, 3};
+  ASSERT_EQ(queue_buffer.push_n(values), 3);
+
+  std::vector<int> out;
+  ASSERT_EQ(queue_buffer.pop_n(std::back_inserter(out), 2), 2);
+  ASSERT_EQ(out, (std::vector<int>{1, 2}));
+  ASSERT_EQ(queue_buffer.pop_n(std::back_inserter(out), 8), 1);
+  ASSERT_EQ(out, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(SpscQueueTest, ReserveAndCommit) {
+  auto slot = queue_buffer.try_reserve();
+  ASSERT_TRUE(slot.has_value());
+  slot->get() = 7;
+  ASSERT_TRUE(queue_buffer.empty()); // not visible until committed
+  queue_buffer.commit();
+  ASSERT_FALSE(queue_buffer.empty());
+
+  int actual(-1);
+  ASSERT_TRUE(queue_buffer.pop(actual));
+  ASSERT_EQ(actual, 7);
+}
+
+TEST_F(SpscQueueTest, ReserveFull) {
+  ASSERT_TRUE(queue_buffer.push(1));
+  ASSERT_TRUE(queue_buffer.push(2));
+  ASSERT_TRUE(queue_buffer.push(3));
+  ASSERT_FALSE(queue_buffer.try_reserve().has_value());
+}
+
+TEST_F(SpscQueueTest, FrontAndRelease) {
+  ASSERT_FALSE(queue_buffer.front().has_value());
+  ASSERT_TRUE(queue_buffer.push(1));
+  ASSERT_TRUE(queue_buffer.push(2));
+
+  auto front = queue_buffer.front();
+  ASSERT_TRUE(front.has_value());
+  ASSERT_EQ(front->get(), 1);
+  ASSERT_EQ(queue_buffer.front()->get(), 1); // peeking does not consume
+  queue_buffer.release();
+
+  ASSERT_EQ(queue_buffer.front()->get(), 2);
+  queue_buffer.release();
+  ASSERT_TRUE(queue_buffer.empty());
+}
+
+TEST_F(SpscQueueTest, InPlaceWrapAround) {
+  for (int i = 0; i < 10; ++i) {
+    auto slot = queue_buffer.try_reserve();
+    ASSERT_TRUE(slot.has_value());
+    slot->get() = i;
+    queue_buffer.commit();
+
+    auto front = queue_buffer.front();
+    ASSERT_TRUE(front.has_value());
+    ASSERT_EQ(front->get(), i);
+    queue_buffer.release();
+  }
+  ASSERT_TRUE(queue_buffer.empty());
+}
+
+TEST(SpscQueueBatchTest, NonTriviallyCopyable) {
+  loon::SpscQueue<std::string, 4> queue;
+  const std::array<std::string, 3> first{"a", "b", "c"};
+  ASSERT_EQ(queue.push_n(first), 3);
+
+  std::array<std::string, 2> out;
+  ASSERT_EQ(queue.pop_n(std::span<std::string>(out)), 2);
+  ASSERT_EQ(out[0], "a");
+  ASSERT_EQ(out[1], "b");
+
+  const std::array<std::string, 3> second{"d", "e", "f"};
+  ASSERT_EQ(queue.push_n(second), 3);
+
+  std::vector<std::string> rest;
+  ASSERT_EQ(queue.pop_n(std::back_inserter(rest), 4), 4);
+  ASSERT_EQ(rest, (std::vector<std::string>{"c", "d", "e", "f"}));
+}
+
+TEST(SpscQueueMaskTest, PowerOfTwoWrapAround) {
+  loon::SpscQueue<int, 4> queue;
+  int actual(-1);
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue.push(i));
+    ASSERT_TRUE(queue.pop(actual));
+    ASSERT_EQ(actual, i);
+  }
+}
+
+TEST(SpscQueueDynamicTest, CapacityRoundedToPowerOfTwo) {
+  loon::SpscQueue<int, loon::DYNAMIC_CAPACITY> queue(1000);
+  EXPECT_EQ(queue.capacity(), 1024);
+  loon::SpscQueue<int, loon::DYNAMIC_CAPACITY> exact(8);
+  EXPECT_EQ(exact.capacity(), 8);
+  loon::SpscQueue<int, loon::DYNAMIC_CAPACITY> minimal(0);
+  EXPECT_EQ(minimal.capacity(), 1);
+}
+
+TEST(SpscQueueDynamicTest, PushFullAndWrapAround) {
+  loon::SpscQueue<int, loon::DYNAMIC_CAPACITY> queue(3); // rounded to 4
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(queue.push(i));
+  }
+  ASSERT_TRUE(queue.full());
+  ASSERT_FALSE(queue.push(4));
+
+  int actual(-1);
+  ASSERT_TRUE(queue.pop(actual));
+  ASSERT_EQ(actual, 0);
+  ASSERT_TRUE(queue.push(4));
+
+  std::vector<int> out;
+  ASSERT_EQ(queue.pop_n(std::back_inserter(out), 8), 4);
+  ASSERT_EQ(out, (std::vector<int>{1, 2, 3, 4}));
+}
+
+TEST(SpscQueueDynamicTest, HugePageStorage) {
+  // Huge falls back to transparent huge pages when no hugetlb pages are reserved
+  for (auto pages : {loon::PageMode::Transparent, loon::PageMode::Huge}) {
+    loon::SpscQueue<std::string, loon::DYNAMIC_CAPACITY> queue(1 << 12, pages);
+    ASSERT_EQ(queue.capacity(), 1 << 12);
+    for (int i = 0; i < 5000; ++i) {
+      ASSERT_TRUE(queue.push(std::to_string(i)));
+      std::string actual;
+      ASSERT_TRUE(queue.pop(actual));
+      ASSERT_EQ(actual, std::to_string(i));
+    }
+  }
+}
+
+TEST(SpscQueueInstrumentTest, RecordsEveryPopPath) {
+  loon::SpscQueue<int, 8, loon::DwellInstrumentation> queue;
+  ASSERT_TRUE(queue.push(1));
+  ASSERT_TRUE(queue.push(2));
+  ASSERT_TRUE(queue.push(3));
+  auto slot = queue.try_reserve();
+  ASSERT_TRUE(slot.has_value());
+  slot->get() = 4;
+  queue.commit();
+  const std::array<int, 2> batch{5, 6};
+  EXPECT_EQ(queue.push_n(batch), 2);
+
+  int value(-1);
+  ASSERT_TRUE(queue.pop(value));
+  ASSERT_TRUE(queue.front().has_value());
+  queue.release();
+  std::array<int, 4> out{};
+  EXPECT_EQ(queue.pop_n(out), 4);
+
+  const auto stats = queue.instrumentation().snapshot();
+  EXPECT_EQ(stats.total, 6);
+  EXPECT_EQ(stats.high_water, 6);
+
+  queue.instrumentation().reset();
+  EXPECT_EQ(queue.instrumentation().snapshot().total, 0);
+  EXPECT_EQ(queue.instrumentation().snapshot().high_water, 0);
+}
+
+TEST(SpscQueueInstrumentTest, DisabledPolicyAddsNoStorage) {
+  // Same layout as SpscQueue<int, 16> without an instrumentation member
+  struct Replica {
+    int slots[16];
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> write_idx;
+    alignas(CACHE_LINE_SIZE) size_t write_idx_cache;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> read_idx;
+    alignas(CACHE_LINE_SIZE) size_t read_idx_cache;
+    bool reserved;
+  };
+  static_assert(std::is_empty_v<loon::NoInstrumentation>);
+  EXPECT_EQ(sizeof(loon::SpscQueue<int, 16>), sizeof(Replica));
+}
+
+// Counts live instances so tests can check every constructed element is destroyed once
+struct Tracked {
+  static inline int live = 0;
+
+  explicit Tracked(int v) : value(v) { ++live; }
+  Tracked(const Tracked& other) : value(other.value) { ++live; }
+  Tracked& operator=(const Tracked&) = default;
+  ~Tracked() { --live; }
+
+  int value;
+};
+
+TEST(SpscQueueStorageTest, MoveOnlyElements) {
+  loon::SpscQueue<std::unique_ptr<int>, 4> queue;
+  auto value = std::make_unique<int>(1);
+  EXPECT_TRUE(queue.push(std::move(value)));
+  EXPECT_EQ(value, nullptr);
+  EXPECT_TRUE(queue.emplace(new int(2)));
+
+  std::unique_ptr<int> popped;
+  EXPECT_TRUE(queue.pop(popped));
+  EXPECT_EQ(*popped, 1);
+  auto second = queue.pop();
+  ASSERT_TRUE(second.has_value());
+  EXPECT_EQ(**second, 2);
+  EXPECT_FALSE(queue.pop().has_value());
+}
+
+TEST(SpscQueueStorageTest, FailedPushDoesNotMoveFrom) {
+  loon::SpscQueue<std::unique_ptr<int>, 1> queue;
+  EXPECT_TRUE(queue.emplace(new int(1)));
+  auto value = std::make_unique<int>(2);
+  EXPECT_FALSE(queue.push(std::move(value)));
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(*value, 2);
+}
+
+TEST(SpscQueueStorageTest, ConstructsOnlyPushedElements) {
+  Tracked::live = 0;
+  {
+    loon::SpscQueue<Tracked, 8> queue;
+    EXPECT_EQ(Tracked::live, 0);
+    EXPECT_TRUE(queue.emplace(1));
+    EXPECT_TRUE(queue.emplace(2));
+    EXPECT_TRUE(queue.emplace(3));
+    EXPECT_EQ(Tracked::live, 3);
+
+    auto value = queue.pop();
+    ASSERT_TRUE(value.has_value());
+    EXPECT_EQ(value->value, 1);
+    EXPECT_EQ(Tracked::live, 3); // two queued plus the popped copy
+    value.reset();
+    queue.release();
+    EXPECT_EQ(Tracked::live, 1);
+  }
+  EXPECT_EQ(Tracked::live, 0); // the queue destroyed the element it still held
+}
+
+TEST(SpscQueueStorageTest, BatchesDestroyPoppedSlots) {
+  Tracked::live = 0;
+  {
+    loon::SpscQueue<Tracked, 4> queue;
+    const std::array<Tracked, 3> values{Tracked(1), Tracked(2), Tracked(3)};
+    for (int lap = 0; lap < 3; ++lap) {
+      EXPECT_EQ(queue.push_n(values), 3);
+      EXPECT_EQ(Tracked::live, 6);
+      std::vector<Tracked> out;
+      EXPECT_EQ(queue.pop_n(std::back_inserter(out), 3), 3);
+      EXPECT_EQ(out.back().value, 3);
+      EXPECT_EQ(Tracked::live, 6);
+    }
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SpscQueueStorageTest, DynamicCapacityDestroysRemaining) {
+  Tracked::live = 0;
+  {
+    loon::SpscQueue<Tracked, loon::DYNAMIC_CAPACITY> queue(16);
+    for (int i = 0; i < 10; ++i) {
+      EXPECT_TRUE(queue.emplace(i));
+    }
+    EXPECT_EQ(Tracked::live, 10);
+  }
+  EXPECT_EQ(Tracked::live, 0);
+}
+
+TEST(SpscQueueStorageTest, UncommittedReservationIsDestroyed) {
+  loon::SpscQueue<std::string, 2> queue;
+  auto slot = queue.try_reserve();
+  ASSERT_TRUE(slot.has_value());
+  slot->get().assign(100, 'x'); // heap allocation that only the destructor can free
+}
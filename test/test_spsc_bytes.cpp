@@ -0,0 +1,134 @@
+#include <loon/spsc_bytes.hpp>
+
+#include <cstddef>
+#include <cstring>
+#include <gtest/gtest.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace {
+
+std::span<const std::byte> as_bytes(std::string_view text) {
+  return std::as_bytes(std::span<const char>(text.data(), text.size()));
+}
+
+std::string as_string(std::span<const std::byte> bytes) {
+  return std::string(reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
+} // namespace
+
+class SpscBytesTest : public ::testing::Test {
+ protected:
+  loon::SpscBytes<64> ring;
+};
+
+TEST_F(SpscBytesTest, EmptyOnConstruction) {
+  EXPECT_TRUE(ring.empty());
+  EXPECT_EQ(ring.capacity(), 64);
+  EXPECT_EQ(ring.max_record_size(), 24);
+  EXPECT_FALSE(ring.front().has_value());
+}
+
+TEST_F(SpscBytesTest, PushAndFront) {
+  ASSERT_TRUE(ring.push(as_bytes("hello")));
+  ASSERT_TRUE(ring.push(as_bytes("loon")));
+
+  auto record = ring.front();
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(as_string(*record), "hello");
+  ring.release();
+
+  record = ring.front();
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(as_string(*record), "loon");
+  ring.release();
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(SpscBytesTest, PushFull) {
+  // Each 8-byte payload takes 16 bytes with its header
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_TRUE(ring.push(as_bytes("12345678")));
+  }
+  EXPECT_FALSE(ring.push(as_bytes("x")));
+}
+
+TEST_F(SpscBytesTest, RecordTooLarge) {
+  EXPECT_FALSE(ring.try_reserve(25).has_value());
+  EXPECT_TRUE(ring.try_reserve(24).has_value());
+}
+
+TEST_F(SpscBytesTest, ReserveAndCommitShorter) {
+  auto region = ring.try_reserve(24);
+  ASSERT_TRUE(region.has_value());
+  ASSERT_EQ(region->size(), 24);
+  std::memcpy(region->data(), "abc", 3);
+  EXPECT_TRUE(ring.empty()); // not visible until committed
+  ring.commit(3);
+
+  auto record = ring.front();
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(as_string(*record), "abc");
+}
+
+TEST_F(SpscBytesTest, RecordNeverSplitAcrossWrap) {
+  // Advance the indices to offset 48 so only 16 bytes remain before the wrap point
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(ring.push(as_bytes("12345678")));
+    ASSERT_TRUE(ring.front().has_value());
+    ring.release();
+  }
+
+  const std::string payload(20, 'w'); // 32 bytes with header, does not fit the tail
+  ASSERT_TRUE(ring.push(as_bytes(payload)));
+
+  auto record = ring.front();
+  ASSERT_TRUE(record.has_value());
+  EXPECT_EQ(as_string(*record), payload);
+  ring.release();
+  EXPECT_TRUE(ring.empty());
+}
+
+TEST_F(SpscBytesTest, WrapNeedsRoomForPadding) {
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_TRUE(ring.push(as_bytes("12345678")));
+  }
+  ASSERT_TRUE(ring.front().has_value());
+  ring.release();
+
+  // 16 bytes free at the tail and 16 at the head: a 32-byte record cannot fit contiguously
+  EXPECT_FALSE(ring.push(as_bytes(std::string(20, 'w'))));
+  EXPECT_TRUE(ring.push(as_bytes("12345678")));
+}
+
+TEST_F(SpscBytesTest, MaxRecordFitsAtAnyOffset) {
+  // An odd-sized record leaves the indices at offset 8, one header past a wrap boundary
+  ASSERT_TRUE(ring.push(as_bytes("x")));
+  ASSERT_TRUE(ring.front().has_value());
+  ring.release();
+
+  const std::string payload(ring.max_record_size(), 'm');
+  for (int i = 0; i < 8; ++i) {
+    auto region = ring.try_reserve(payload.size());
+    ASSERT_TRUE(region.has_value()) << "iteration " << i;
+    std::memcpy(region->data(), payload.data(), payload.size());
+    ring.commit(payload.size());
+
+    auto record = ring.front();
+    ASSERT_TRUE(record.has_value());
+    EXPECT_EQ(as_string(*record), payload);
+    ring.release();
+    EXPECT_TRUE(ring.empty());
+  }
+}
+
+TEST_F(SpscBytesTest, ZeroLengthRecord) {
+  ASSERT_TRUE(ring.push({}));
+  auto record = ring.front();
+  ASSERT_TRUE(record.has_value());
+  EXPECT_TRUE(record->empty());
+  ring.release();
+  EXPECT_TRUE(ring.empty());
+}
@@ -0,0 +1,212 @@
+#include <loon/time_window.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <gtest/gtest.h>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+// A steady clock the tests move by hand
+struct ManualClock {
+  using duration = std::chrono::nanoseconds;
+  using rep = duration::rep;
+  using period = duration::period;
+  using time_point = std::chrono::time_point<ManualClock>;
+  static constexpr bool is_steady = true;
+
+  static inline time_point current{};
+  static time_point now() { return current; }
+};
+
+using Stamp = ManualClock::time_point;
+
+template <typename T, size_t N>
+using Window = loon::TimeWindow<T, N, ManualClock>;
+
+template <typename T, size_t N>
+static std::vector<T> contents(const Window<T, N>& window) {
+  std::vector<T> values;
+  window.for_each([&](Stamp, const T& value) { values.push_back(value); });
+  return values;
+}
+
+TEST(TimeWindowTest, EmptyWindow) {
+  Window<int, 8> window(1ms);
+  EXPECT_TRUE(window.empty());
+  EXPECT_EQ(window.size(), 0);
+  EXPECT_EQ(window.capacity(), 8);
+  EXPECT_EQ(window.horizon(), 1ms);
+  EXPECT_FALSE(window.front().has_value());
+  EXPECT_FALSE(window.back().has_value());
+  EXPECT_EQ(window.expire(Stamp{1s}), 0);
+}
+
+TEST(TimeWindowTest, CapacityRoundsUpToPowerOfTwo) {
+  Window<int, 5> window(1ms);
+  EXPECT_EQ(window.capacity(), 8);
+}
+
+TEST(TimeWindowTest, ExpiresElementsOlderThanHorizon) {
+  Window<int, 16> window(10ms);
+  for (int i = 0; i < 5; ++i) {
+    window.push_at(Stamp{i * 5ms}, i); // stamped 0, 5, 10, 15, 20 ms
+  }
+  EXPECT_EQ(window.count(Stamp{20ms}), 2); // 10 ms and older have aged out
+  EXPECT_EQ(contents(window), (std::vector<int>{3, 4}));
+  EXPECT_EQ(window.front(), 3);
+  EXPECT_EQ(window.back(), 4);
+  EXPECT_EQ(window.count(Stamp{30ms}), 0);
+  EXPECT_TRUE(window.empty());
+}
+
+TEST(TimeWindowTest, PushExpiresLazily) {
+  Window<int, 16> window(10ms);
+  window.push_at(Stamp{0ms}, 1);
+  window.push_at(Stamp{4ms}, 2);
+  EXPECT_EQ(window.size(), 2);
+
+  window.push_at(Stamp{12ms}, 3); // drops the 0 ms element only
+  EXPECT_EQ(contents(window), (std::vector<int>{2, 3}));
+}
+
+TEST(TimeWindowTest, BulkExpiryDropsEveryStaleElementAtOnce) {
+  Window<int, 1024> window(100ms);
+  for (int i = 0; i < 1000; ++i) {
+    window.push_at(Stamp{std::chrono::microseconds(i * 100)}, i); // 0 to 99.9 ms
+  }
+  EXPECT_EQ(window.expire(Stamp{150ms}), 501); // everything at or before 50 ms
+  EXPECT_EQ(window.front(), 501);
+  EXPECT_EQ(window.size(), 499);
+}
+
+TEST(TimeWindowTest, EqualStampsExpireTogether) {
+  Window<int, 16> window(10ms);
+  for (int i = 0; i < 6; ++i) {
+    window.push_at(Stamp{i < 3 ? 1ms : 2ms}, i);
+  }
+  EXPECT_EQ(window.expire(Stamp{11ms}), 3);
+  EXPECT_EQ(window.expire(Stamp{12ms}), 3);
+}
+
+TEST(TimeWindowTest, UsesClockWithoutTimestamp) {
+  Window<int, 8> window(10ms);
+  ManualClock::current = Stamp{100ms};
+  window.push(1);
+  ManualClock::current = Stamp{105ms};
+  window.push(2);
+  EXPECT_EQ(window.count(), 2);
+  ManualClock::current = Stamp{111ms};
+  EXPECT_EQ(window.count(), 1);
+  EXPECT_EQ(window.expire(), 0);
+  ManualClock::current = Stamp{115ms};
+  EXPECT_EQ(window.expire(), 1);
+}
+
+TEST(TimeWindowTest, EvictDropsOldestWhenBurstExceedsCapacity) {
+  Window<int, 4> window(1s);
+  for (int i = 0; i < 10; ++i) {
+    window.push_at(Stamp{0ms}, i);
+  }
+  EXPECT_EQ(window.capacity(), 4);
+  EXPECT_EQ(window.dropped(), 6);
+  EXPECT_EQ(contents(window), (std::vector<int>{6, 7, 8, 9}));
+}
+
+TEST(TimeWindowTest, GrowKeepsEveryElementOfABurst) {
+  Window<int, 4> window(1s, loon::WindowOverflow::Grow);
+  window.push_at(Stamp{0ms}, -2);
+  window.push_at(Stamp{0ms}, -1);
+  (void)window.count(Stamp{1s}); // move the head off slot 0 so growth has to unwrap
+  for (int i = 0; i < 10; ++i) {
+    window.push_at(Stamp{1s}, i);
+  }
+  EXPECT_EQ(window.capacity(), 16);
+  EXPECT_EQ(window.dropped(), 0);
+  EXPECT_EQ(contents(window), (std::vector<int>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+
+  // The grown storage is kept and reused
+  EXPECT_EQ(window.count(Stamp{3s}), 0);
+  EXPECT_EQ(window.capacity(), 16);
+}
+
+TEST(TimeWindowTest, MatchesDequeReference) {
+  Window<int, 8> window(5ms, loon::WindowOverflow::Grow);
+  std::deque<std::pair<Stamp, int>> reference;
+  std::mt19937 rng(11);
+  std::uniform_int_distribution<int> gap(0, 3);
+  std::uniform_int_distribution<int> burst(1, 40);
+  Stamp now{};
+
+  for (int round = 0; round < 500; ++round) {
+    now += std::chrono::milliseconds(gap(rng));
+    for (int i = burst(rng); i > 0; --i) {
+      window.push_at(now, round);
+      reference.emplace_back(now, round);
+    }
+    while (!reference.empty() && reference.front().first <= now - 5ms) {
+      reference.pop_front();
+    }
+    ASSERT_EQ(window.count(now), reference.size());
+    ASSERT_EQ(window.front(), reference.front().second);
+  }
+}
+
+TEST(TimeWindowTest, ForEachSeesStamps) {
+  Window<int, 8> window(1s);
+  window.push_at(Stamp{1ms}, 10);
+  window.push_at(Stamp{2ms}, 20);
+  std::vector<Stamp> stamps;
+  window.for_each([&](Stamp stamp, int) { stamps.push_back(stamp); });
+  EXPECT_EQ(stamps, (std::vector<Stamp>{Stamp{1ms}, Stamp{2ms}}));
+}
+
+TEST(TimeWindowTest, DefaultsToSteadyClock) {
+  loon::TimeWindow<int, 8> window(std::chrono::hours(1));
+  window.push(1);
+  window.push(2);
+  EXPECT_EQ(window.count(), 2);
+}
+
+// ----------------------------------------------------------------------------
+// Element lifetimes
+// ----------------------------------------------------------------------------
+
+TEST(TimeWindowStorageTest, MoveOnlyElements) {
+  Window<std::unique_ptr<int>, 2> window(10ms, loon::WindowOverflow::Grow);
+  for (int i = 0; i < 5; ++i) {
+    window.push_at(Stamp{0ms}, std::make_unique<int>(i));
+  }
+  window.emplace_at(Stamp{0ms}, new int(5));
+  int sum = 0;
+  window.for_each([&](Stamp, const std::unique_ptr<int>& p) { sum += *p; });
+  EXPECT_EQ(sum, 15);
+}
+
+TEST(TimeWindowStorageTest, DestroysExpiredAndRemainingElements) {
+  auto token = std::make_shared<int>(0);
+  {
+    Window<std::shared_ptr<int>, 4> window(10ms);
+    for (int i = 0; i < 6; ++i) {
+      window.push_at(Stamp{std::chrono::milliseconds(i)}, token);
+    }
+    EXPECT_EQ(token.use_count(), 5); // 2 evicted by the cap
+    EXPECT_EQ(window.expire(Stamp{13ms}), 2);
+    EXPECT_EQ(token.use_count(), 3);
+  }
+  EXPECT_EQ(token.use_count(), 1);
+}
+
+TEST(TimeWindowStorageTest, GrowMovesStrings) {
+  Window<std::string, 2> window(10ms, loon::WindowOverflow::Grow);
+  for (int i = 0; i < 9; ++i) {
+    window.push_at(Stamp{0ms}, std::string(32, static_cast<char>('a' + i)));
+  }
+  EXPECT_EQ(window.front(), std::string(32, 'a'));
+  EXPECT_EQ(window.back(), std::string(32, 'i'));
+}
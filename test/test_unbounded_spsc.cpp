@@ -0,0 +1,113 @@
+#include <loon/unbounded_spsc.hpp>
+
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+
+class UnboundedSpscQueueTest : public ::testing::Test {
+ protected:
+  loon::UnboundedSpscQueue<int, 4> queue;
+};
+
+TEST_F(UnboundedSpscQueueTest, PushPopWithinOneSegment) {
+  EXPECT_TRUE(queue.empty());
+  queue.push(1);
+  queue.push(2);
+  EXPECT_FALSE(queue.empty());
+
+  int actual(-1);
+  ASSERT_TRUE(queue.pop(actual));
+  EXPECT_EQ(actual, 1);
+  ASSERT_TRUE(queue.pop(actual));
+  EXPECT_EQ(actual, 2);
+  EXPECT_FALSE(queue.pop(actual));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(UnboundedSpscQueueTest, GrowsPastSegmentCapacity) {
+  constexpr int count = 100;
+  for (int i = 0; i < count; ++i) {
+    queue.push(i);
+  }
+  int actual(-1);
+  for (int i = 0; i < count; ++i) {
+    ASSERT_TRUE(queue.pop(actual));
+    EXPECT_EQ(actual, i);
+  }
+  EXPECT_FALSE(queue.pop(actual));
+  EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(UnboundedSpscQueueTest, InterleavedAcrossSegments) {
+  int next_push = 0;
+  int next_pop = 0;
+  int actual(-1);
+  for (int round = 0; round < 50; ++round) {
+    for (int i = 0; i < 7; ++i) {
+      queue.push(next_push++);
+    }
+    for (int i = 0; i < 5; ++i) {
+      ASSERT_TRUE(queue.pop(actual));
+      EXPECT_EQ(actual, next_pop++);
+    }
+  }
+  while (queue.pop(actual)) {
+    EXPECT_EQ(actual, next_pop++);
+  }
+  EXPECT_EQ(next_pop, next_push);
+}
+
+// Repeated bursts larger than a segment reuse drained segments
+TEST_F(UnboundedSpscQueueTest, RecycledSegmentsStartEmpty) {
+  int actual(-1);
+  for (int burst = 0; burst < 10; ++burst) {
+    for (int i = 0; i < 20; ++i) {
+      queue.push(burst * 100 + i);
+    }
+    for (int i = 0; i < 20; ++i) {
+      ASSERT_TRUE(queue.pop(actual));
+      EXPECT_EQ(actual, burst * 100 + i);
+    }
+    EXPECT_FALSE(queue.pop(actual));
+  }
+}
+
+TEST(UnboundedSpscQueueMisc, NonTrivialType) {
+  loon::UnboundedSpscQueue<std::string, 2> queue(1);
+  for (int i = 0; i < 10; ++i) {
+    queue.push(std::string(32, static_cast<char>('a' + i)));
+  }
+  std::string actual;
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_TRUE(queue.pop(actual));
+    EXPECT_EQ(actual, std::string(32, static_cast<char>('a' + i)));
+  }
+}
+
+TEST(UnboundedSpscQueueMisc, DestroysWithPendingElements) {
+  loon::UnboundedSpscQueue<std::string, 2> queue;
+  for (int i = 0; i < 9; ++i) {
+    queue.push("pending");
+  }
+}
+
+TEST(UnboundedSpscQueueMisc, ProducerConsumer) {
+  loon::UnboundedSpscQueue<int, 64> queue;
+  constexpr int count = 100000;
+
+  std::thread producer([&] {
+    for (int i = 0; i < count; ++i) {
+      queue.push(i);
+    }
+  });
+
+  int actual(-1);
+  for (int i = 0; i < count; ++i) {
+    while (!queue.pop(actual)) {
+      std::this_thread::yield();
+    }
+    ASSERT_EQ(actual, i);
+  }
+  producer.join();
+  EXPECT_TRUE(queue.empty());
+}
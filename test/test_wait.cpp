@@ -0,0 +1,99 @@
+#include <loon/spsc.hpp>
+#include <loon/wait.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+template <typename Wait>
+class BlockingQueueTest : public ::testing::Test {
+ protected:
+  loon::BlockingQueue<loon::SpscQueue<int, 4>, Wait> queue;
+};
+
+using WaitStrategies = ::testing::Types<loon::SpinWait, loon::YieldWait<>, loon::ParkWait<>>;
+TYPED_TEST_SUITE(BlockingQueueTest, WaitStrategies);
+
+TYPED_TEST(BlockingQueueTest, PushAndPopWithoutWaiting) {
+  int actual(-1);
+  EXPECT_FALSE(this->queue.pop(actual));
+  EXPECT_TRUE(this->queue.push(1));
+  EXPECT_FALSE(this->queue.empty());
+  EXPECT_TRUE(this->queue.pop(actual));
+  EXPECT_EQ(actual, 1);
+  EXPECT_EQ(this->queue.capacity(), 4);
+}
+
+TYPED_TEST(BlockingQueueTest, ProducerConsumer) {
+  constexpr int count = 1000;
+
+  // Small capacity forces the producer to wait on full and the consumer on empty
+  std::thread consumer([&] {
+    for (int i = 0; i < count; ++i) {
+      int actual(-1);
+      this->queue.pop_wait(actual);
+      ASSERT_EQ(actual, i);
+    }
+  });
+
+  for (int i = 0; i < count; ++i) {
+    this->queue.push_wait(i);
+  }
+  consumer.join();
+  EXPECT_TRUE(this->queue.empty());
+}
+
+TYPED_TEST(BlockingQueueTest, WakesIdleConsumer) {
+  int actual(-1);
+  std::thread consumer([&] { this->queue.pop_wait(actual); });
+
+  // Give the consumer time to exhaust its spins and park
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  this->queue.push_wait(42);
+  consumer.join();
+  EXPECT_EQ(actual, 42);
+}
+
+TYPED_TEST(BlockingQueueTest, WakesIdleProducer) {
+  for (int i = 0; i < 4; ++i) {
+    this->queue.push_wait(i);
+  }
+  std::thread producer([&] { this->queue.push_wait(4); });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  int actual(-1);
+  this->queue.pop_wait(actual);
+  EXPECT_EQ(actual, 0);
+  producer.join();
+  EXPECT_TRUE(this->queue.full());
+}
+
+TEST(SpinLockTest, TryLock) {
+  loon::SpinLock<> lock;
+  EXPECT_TRUE(lock.try_lock());
+  EXPECT_FALSE(lock.try_lock());
+  lock.unlock();
+  EXPECT_TRUE(lock.try_lock());
+  lock.unlock();
+}
+
+TEST(SpinLockTest, MutualExclusion) {
+  loon::SpinLock<> lock;
+  uint64_t counter = 0; // Unsynchronized except through the lock
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&] {
+      for (int i = 0; i < 50000; ++i) {
+        std::lock_guard guard(lock);
+        ++counter;
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(counter, 200000);
+}